@@ -44,6 +44,7 @@
 #include <cartesian_controller_base/cartesian_controller_base.h>
 #include <cartesian_motion_controller/cartesian_motion_controller.h>
 #include <cartesian_force_controller/cartesian_force_controller.h>
+#include <cartesian_controller_base/TripleBuffer.h>
 
 // Dynamic reconfigure
 #include <dynamic_reconfigure/server.h>
@@ -94,6 +95,16 @@ class CartesianComplianceController
     typedef cartesian_force_controller::CartesianForceController<HardwareInterface> ForceBase;
 
   private:
+    /**
+     * @brief Move the internal model towards equilibrium of spring and net force
+     *
+     * This is everything of update() except writing the commands to the
+     * hardware, so that it can run on an asynchronous worker.
+     *
+     * @param time The time of this control cycle
+     */
+    void computeJointMotion(const ros::Time& time);
+
     /**
      * @brief Compute the net force out of target wrench and stiffness-related pose offset
      *
@@ -101,8 +112,27 @@ class CartesianComplianceController
      */
     ctrl::Vector6D        computeComplianceError();
 
-    ctrl::Matrix6D        m_stiffness;
+    /**
+     * @brief Display the stiffness in the robot base frame
+     *
+     * The result only depends on the stiffness and on the orientation of the
+     * compliance reference frame.  It's recomputed only if one of them
+     * changed since the last call.
+     */
+    void updateBaseStiffness();
+
+    ctrl::Vector6D        m_stiffness;  ///< Diagonal, in the compliance reference frame
     std::string           m_compliance_ref_link;
+    int                   m_compliance_ref_link_index;
+
+    // Stiffness in the robot base frame.  Only the diagonal blocks are used.
+    ctrl::Matrix3D        m_base_stiffness_trans;
+    ctrl::Matrix3D        m_base_stiffness_rot;
+    ctrl::Matrix3D        m_base_stiffness_rotation;  ///< Of the compliance reference frame
+    bool                  m_base_stiffness_valid;
+
+    // Lock-free handoff from dynamic reconfigure to the realtime loop
+    cartesian_controller_base::TripleBuffer<ctrl::Vector6D> m_stiffness_buffer;
 
     // Dynamic reconfigure for stiffness
     typedef cartesian_compliance_controller::ComplianceControllerConfig
@@ -57,7 +57,8 @@ CartesianComplianceController()
 // explicitly
 : Base::CartesianControllerBase(),
   MotionBase::CartesianMotionController(),
-  ForceBase::CartesianForceController()
+  ForceBase::CartesianForceController(),
+  m_base_stiffness_valid(false)
 {
 }
 
@@ -83,10 +84,14 @@ init(HardwareInterface* hw, ros::NodeHandle& nh)
                                            << Base::m_end_effector_link);
     return false;
   }
+  m_compliance_ref_link_index = Base::getLinkIndex(m_compliance_ref_link);
 
   // Make sure sensor wrenches are interpreted correctly
   ForceBase::setFtSensorReferenceFrame(m_compliance_ref_link);
 
+  m_stiffness.setZero();
+  m_stiffness_buffer.initRT(m_stiffness);
+
   // Connect dynamic reconfigure and overwrite the default values with values
   // on the parameter server. This is done automatically if parameters with
   // the according names exist.
@@ -98,6 +103,9 @@ init(HardwareInterface* hw, ros::NodeHandle& nh)
         ros::NodeHandle(nh.getNamespace() + "/stiffness")));
   m_dyn_conf_server->setCallback(m_callback_type);
 
+  // Replaces the steps of both parents
+  Base::setSolverTask([this](const ros::Time& time){ computeJointMotion(time); });
+
   return true;
 }
 
@@ -122,12 +130,49 @@ stopping(const ros::Time& time)
 template <class HardwareInterface>
 void CartesianComplianceController<HardwareInterface>::
 update(const ros::Time& time, const ros::Duration& period)
+{
+  auto allocations = Base::trackAllocations();
+
+  // Filter every sensor sample on the realtime thread, also between solver
+  // cycles and while the asynchronous worker is busy
+  ForceBase::updateFtSensorWrench(time);
+
+  // Between solver cycles, only move on towards the last solution
+  if (Base::interpolateJointControlCmds())
+  {
+    return;
+  }
+
+  // Optionally solve on the asynchronous worker instead
+  if (Base::solveAsynchronously(time))
+  {
+    return;
+  }
+
+  computeJointMotion(time);
+
+  // Write final commands to the hardware interface
+  Base::writeJointControlCmds();
+}
+
+template <class HardwareInterface>
+void CartesianComplianceController<HardwareInterface>::
+computeJointMotion(const ros::Time& time)
 {
   // Synchronize the internal model and the real robot
-  Base::m_ik_solver->synchronizeJointPositions(Base::m_joint_handles);
+  Base::startStageTimer();
+  Base::synchronizeJointPositions();
+  MotionBase::updateTargetFrame(time);
+  if (m_stiffness_buffer.hasNewData())
+  {
+    m_stiffness = *m_stiffness_buffer.readFromRT();
+    m_base_stiffness_valid = false;
+  }
+  Base::lapStageTimer(Base::SYNCHRONIZATION);
 
   // Control the robot motion in such a way that the resulting net force
   // vanishes. This internal control needs some simulation time steps.
+  Base::beginIterations();
   for (int i = 0; i < Base::m_iterations; ++i)
   {
     // The internal 'simulation time' is deliberately independent of the outer
@@ -136,30 +181,65 @@ update(const ros::Time& time, const ros::Duration& period)
 
     // Compute the net force
     ctrl::Vector6D error = computeComplianceError();
+    Base::lapStageTimer(Base::ERROR_COMPUTATION);
+    if (!Base::continueIterations(error))
+    {
+      break;
+    }
 
     // Turn Cartesian error into joint motion
     Base::computeJointControlCmds(error,internal_period);
   }
-
-  // Write final commands to the hardware interface
-  Base::writeJointControlCmds();
+  Base::endIterations();
 }
 
 template <class HardwareInterface>
 ctrl::Vector6D CartesianComplianceController<HardwareInterface>::
 computeComplianceError()
 {
-  ctrl::Vector6D net_force =
+  // Spring force in base orientation
+  updateBaseStiffness();
+  const ctrl::Vector6D motion_error = MotionBase::computeMotionError();
+  ctrl::Vector6D net_force;
+  net_force.head<3>().noalias() = m_base_stiffness_trans * motion_error.head<3>();
+  net_force.tail<3>().noalias() = m_base_stiffness_rot * motion_error.tail<3>();
 
-    // Spring force in base orientation
-    Base::displayInBaseLink(m_stiffness,m_compliance_ref_link) * MotionBase::computeMotionError()
-
-    // Sensor and target force in base orientation
-    + ForceBase::computeForceError();
+  // Sensor and target force in base orientation
+  net_force += ForceBase::computeForceError();
 
   return net_force;
 }
 
+template <class HardwareInterface>
+void CartesianComplianceController<HardwareInterface>::
+updateBaseStiffness()
+{
+  // Stiffness given in the base frame
+  if (m_compliance_ref_link_index < 0)
+  {
+    if (!m_base_stiffness_valid)
+    {
+      m_base_stiffness_trans = m_stiffness.head<3>().asDiagonal();
+      m_base_stiffness_rot = m_stiffness.tail<3>().asDiagonal();
+      m_base_stiffness_valid = true;
+    }
+    return;
+  }
+
+  const ctrl::RotationMap R(
+    Base::m_ik_solver->getKinematics().getSegmentFrame(m_compliance_ref_link_index).M.data);
+  if (m_base_stiffness_valid && R == m_base_stiffness_rotation)
+  {
+    return;
+  }
+  m_base_stiffness_rotation = R;
+
+  // Diagonal stiffness only needs one product per block: R * K * R^T
+  m_base_stiffness_trans.noalias() = (R * m_stiffness.head<3>().asDiagonal()) * R.transpose();
+  m_base_stiffness_rot.noalias() = (R * m_stiffness.tail<3>().asDiagonal()) * R.transpose();
+  m_base_stiffness_valid = true;
+}
+
 template <class HardwareInterface>
 void CartesianComplianceController<HardwareInterface>::
 dynamicReconfigureCallback(ComplianceConfig& config, uint32_t level)
@@ -171,7 +251,7 @@ dynamicReconfigureCallback(ComplianceConfig& config, uint32_t level)
   tmp[3] = config.rot_x;
   tmp[4] = config.rot_y;
   tmp[5] = config.rot_z;
-  m_stiffness = tmp.asDiagonal();
+  m_stiffness_buffer.writeFromNonRT(tmp);
 }
 
 } // namespace
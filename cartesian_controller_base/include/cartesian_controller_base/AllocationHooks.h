@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    AllocationHooks.h
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef ALLOCATION_HOOKS_H_INCLUDED
+#define ALLOCATION_HOOKS_H_INCLUDED
+
+/**
+ * Replaces the heap allocation functions of the C library with versions that
+ * report to the current \ref cartesian_controller_base::AllocationTracker of
+ * the calling thread.  This covers operator new, which allocates with
+ * malloc, as well as Eigen's dynamic matrices.
+ *
+ * Include this header in exactly one source file of an executable, e.g. the
+ * one with main().  The replacements only take effect in executables, not in
+ * plugin libraries that are loaded at runtime.  They need the GNU C library.
+ * The hooks are never inlined, so that recorded call sites start at the
+ * right frame.
+ */
+
+// Project
+#include <cartesian_controller_base/AllocationTracker.h>
+
+// Other
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <malloc.h>
+
+extern "C"
+{
+  // The allocators of the GNU C library behind the public functions
+  void* __libc_malloc(std::size_t size) noexcept;
+  void* __libc_calloc(std::size_t number, std::size_t size) noexcept;
+  void* __libc_realloc(void* ptr, std::size_t size) noexcept;
+  void* __libc_memalign(std::size_t alignment, std::size_t size) noexcept;
+
+  __attribute__((noinline)) void* malloc(std::size_t size) noexcept
+  {
+    cartesian_controller_base::AllocationTracker::onAllocation(size);
+    return __libc_malloc(size);
+  }
+
+  __attribute__((noinline)) void* calloc(std::size_t number, std::size_t size) noexcept
+  {
+    cartesian_controller_base::AllocationTracker::onAllocation(number * size);
+    return __libc_calloc(number, size);
+  }
+
+  __attribute__((noinline)) void* realloc(void* ptr, std::size_t size) noexcept
+  {
+    cartesian_controller_base::AllocationTracker::onAllocation(size);
+    return __libc_realloc(ptr, size);
+  }
+
+  __attribute__((noinline)) void* memalign(std::size_t alignment, std::size_t size) noexcept
+  {
+    cartesian_controller_base::AllocationTracker::onAllocation(size);
+    return __libc_memalign(alignment, size);
+  }
+
+  __attribute__((noinline)) void* aligned_alloc(std::size_t alignment, std::size_t size) noexcept
+  {
+    cartesian_controller_base::AllocationTracker::onAllocation(size);
+    return __libc_memalign(alignment, size);
+  }
+
+  __attribute__((noinline)) int posix_memalign(void** ptr, std::size_t alignment, std::size_t size) noexcept
+  {
+    // A power of two multiple of sizeof(void*), as required by POSIX
+    if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0)
+    {
+      return EINVAL;
+    }
+    cartesian_controller_base::AllocationTracker::onAllocation(size);
+    void* memory = __libc_memalign(alignment, size);
+    if (!memory)
+    {
+      return ENOMEM;
+    }
+    *ptr = memory;
+    return 0;
+  }
+}
+
+namespace cartesian_controller_base
+{
+  static const bool g_allocation_hooks = (AllocationTracker::setHooked(), true);
+}
+
+#endif
@@ -0,0 +1,263 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    AllocationTracker.h
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef ALLOCATION_TRACKER_H_INCLUDED
+#define ALLOCATION_TRACKER_H_INCLUDED
+
+// Other
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <execinfo.h>
+#include <sstream>
+#include <string>
+
+namespace cartesian_controller_base
+{
+
+/**
+ * @brief Counts the heap allocations of code sections, e.g. of update()
+ *
+ * A \ref Scope makes a tracker the current one of its thread.  All heap
+ * allocations of this thread count for the tracker until the scope ends.
+ * The first allocations at each distinct call site also record a backtrace,
+ * which \ref report turns into symbols.  Recording neither allocates nor
+ * locks, so that tracking doesn't change what it measures.
+ *
+ * The allocations are only seen in programs that include
+ * \ref AllocationHooks.h in one of their source files.  Without the hooks,
+ * all counts stay zero and \ref isHooked returns false.
+ */
+class AllocationTracker
+{
+  public:
+    static constexpr int MAX_CALL_SITES = 16;
+    static constexpr int MAX_FRAMES = 12;
+
+    /**
+     * @brief Track allocations of this thread during the scope's lifetime
+     *
+     * Scopes can be nested. Allocations count for the innermost tracker.
+     */
+    class Scope
+    {
+      public:
+        /**
+         * @param tracker The tracker to count for. Nullptr doesn't track.
+         */
+        explicit Scope(AllocationTracker* tracker)
+          : m_tracker(tracker), m_previous(nullptr), m_allocations(0)
+        {
+          if (m_tracker)
+          {
+            m_previous = current();
+            m_allocations = m_tracker->m_allocations;
+            current() = m_tracker;
+          }
+        }
+
+        ~Scope()
+        {
+          if (m_tracker)
+          {
+            current() = m_previous;
+            ++m_tracker->m_sections;
+            if (m_tracker->m_allocations != m_allocations)
+            {
+              ++m_tracker->m_allocating_sections;
+            }
+          }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+      private:
+        AllocationTracker* m_tracker;
+        AllocationTracker* m_previous;
+        uint64_t           m_allocations;  ///< When the scope started
+    };
+
+    /**
+     * @param name Identifies the tracker in the report
+     */
+    explicit AllocationTracker(const std::string& name = "")
+      : m_name(name)
+    {
+      reset();
+
+      // The first backtrace loads the unwinder, which allocates
+      void* frames[1];
+      backtrace(frames, 1);
+    }
+
+    void reset()
+    {
+      m_allocations = 0;
+      m_bytes = 0;
+      m_sections = 0;
+      m_allocating_sections = 0;
+      m_call_sites = 0;
+      m_recording = false;
+    }
+
+    uint64_t getAllocations() const { return m_allocations; }
+    uint64_t getBytes() const { return m_bytes; }
+
+    //! The number of tracked scopes since the last reset
+    uint64_t getSections() const { return m_sections; }
+
+    //! The number of tracked scopes that allocated
+    uint64_t getAllocatingSections() const { return m_allocating_sections; }
+
+    /**
+     * @brief Summarize the counts and call sites
+     *
+     * Not realtime safe.
+     */
+    std::string report() const
+    {
+      std::stringstream text;
+      text << m_name << (m_name.empty() ? "" : ": ")
+           << m_allocations << " heap allocations (" << m_bytes << " bytes) in "
+           << m_allocating_sections << " of " << m_sections << " tracked sections";
+      for (int i = 0; i < m_call_sites; ++i)
+      {
+        const CallSite& site = m_call_site[i];
+        text << "\n  " << site.count << " allocations at:";
+        char** symbols = backtrace_symbols(site.frames, site.depth);
+        for (int j = SKIPPED_FRAMES; j < site.depth; ++j)
+        {
+          text << "\n    " << (symbols ? symbols[j] : "?");
+        }
+        std::free(symbols);
+      }
+      if (m_call_sites == MAX_CALL_SITES)
+      {
+        text << "\n  Call sites beyond the first " << MAX_CALL_SITES << " are not shown";
+      }
+      return text.str();
+    }
+
+    /**
+     * @brief Count an allocation for the current tracker of this thread
+     *
+     * Call this from the allocation hooks.
+     *
+     * @param size The number of requested bytes
+     */
+    __attribute__((noinline)) static void onAllocation(std::size_t size)
+    {
+      AllocationTracker* tracker = current();
+      if (tracker && !tracker->m_recording)
+      {
+        // Allocations of the unwinder don't count
+        tracker->m_recording = true;
+        tracker->record(size);
+        tracker->m_recording = false;
+      }
+    }
+
+    //! Whether this program counts allocations at all
+    static bool isHooked() { return hooked(); }
+
+    //! Called once by the allocation hooks
+    static void setHooked() { hooked() = true; }
+
+  private:
+    //! The hook, \ref onAllocation and \ref record. They are never inlined.
+    static constexpr int SKIPPED_FRAMES = 3;
+
+    struct CallSite
+    {
+      void*    frames[MAX_FRAMES];
+      int      depth;
+      uint64_t count;
+    };
+
+    __attribute__((noinline)) void record(std::size_t size)
+    {
+      ++m_allocations;
+      m_bytes += size;
+
+      void* frames[MAX_FRAMES];
+      const int depth = backtrace(frames, MAX_FRAMES);
+      for (int i = 0; i < m_call_sites; ++i)
+      {
+        CallSite& site = m_call_site[i];
+        if (site.depth == depth && std::equal(frames, frames + depth, site.frames))
+        {
+          ++site.count;
+          return;
+        }
+      }
+      if (m_call_sites < MAX_CALL_SITES)
+      {
+        CallSite& site = m_call_site[m_call_sites++];
+        std::copy(frames, frames + depth, site.frames);
+        site.depth = depth;
+        site.count = 1;
+      }
+    }
+
+    static AllocationTracker*& current()
+    {
+      static thread_local AllocationTracker* tracker = nullptr;
+      return tracker;
+    }
+
+    static bool& hooked()
+    {
+      static bool hooked = false;
+      return hooked;
+    }
+
+    std::string m_name;
+    uint64_t    m_allocations;
+    uint64_t    m_bytes;
+    uint64_t    m_sections;
+    uint64_t    m_allocating_sections;
+    CallSite    m_call_site[MAX_CALL_SITES];
+    int         m_call_sites;
+    bool        m_recording;  ///< Against counting our own allocations
+};
+
+}
+
+#endif
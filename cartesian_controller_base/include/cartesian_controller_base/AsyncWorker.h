@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    AsyncWorker.h
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef ASYNC_WORKER_H_INCLUDED
+#define ASYNC_WORKER_H_INCLUDED
+
+// Other
+#include <atomic>
+#include <functional>
+#include <semaphore.h>
+#include <thread>
+
+namespace cartesian_controller_base
+{
+
+/**
+ * @brief A task that runs on its own thread without blocking the caller
+ *
+ * In contrast to \ref WorkerPool, \ref start returns immediately.  The caller
+ * polls \ref isBusy, e.g. once per control cycle, to find out when the task
+ * is done.  Everything that the task wrote is visible to the caller once
+ * \ref isBusy returns false.  Starting and polling neither allocate nor lock.
+ *
+ * The worker can be pinned to a CPU core and be given a realtime priority.
+ */
+class AsyncWorker
+{
+  public:
+    AsyncWorker();
+    ~AsyncWorker();
+
+    AsyncWorker(const AsyncWorker&) = delete;
+    AsyncWorker& operator=(const AsyncWorker&) = delete;
+
+    /**
+     * @brief Start the worker thread
+     *
+     * Call this once outside the realtime loop.
+     *
+     * @param task The task to run on each \ref start
+     * @param cpu Optional CPU core to pin the worker to. Negative values keep
+     * it unpinned.
+     * @param priority Optional SCHED_FIFO priority for the worker. Zero keeps
+     * the default scheduling.
+     *
+     * @return True, if the worker could be started as requested
+     */
+    bool init(const std::function<void()>& task, int cpu = -1, int priority = 0);
+
+    /**
+     * @brief Run the task once in the background
+     *
+     * Realtime safe.
+     *
+     * @return False if the previous run is still busy. Nothing is started then.
+     */
+    bool start();
+
+    //! Whether the last run is still busy. Realtime safe.
+    bool isBusy() const { return m_busy.load(std::memory_order_acquire); }
+
+    //! Wait for the last run to finish
+    void wait() const;
+
+  private:
+    void work();
+    void stop();
+
+    std::function<void()> m_task;
+    std::thread           m_worker;
+    sem_t                 m_start;
+    std::atomic<bool>     m_busy;
+    std::atomic<bool>     m_running;
+};
+
+}
+
+#endif
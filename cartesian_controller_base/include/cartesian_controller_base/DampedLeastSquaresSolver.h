@@ -61,6 +61,8 @@ namespace cartesian_controller_base{
    *  Where \f$ J \f$ denotes the manipulator's joint Jacobian and \f$ f \f$ is
    *  the applied force to the end effector.
    *  \f$ \alpha \f$ is a damping term.
+   *  For redundant manipulators, the solver uses the equivalent, but smaller
+   *  formulation \f$ \dot{q} = J^T ( J J^T + \alpha^2 I )^{-1} f \f$.
    *  For controlling end effector motion, e.g. in the
    *  \ref cartesian_motion_controller::CartesianMotionController \f$ f \f$ should be
    *  thought of as an error direction vector that is mapped to wrench space
@@ -78,14 +80,20 @@ class DampedLeastSquaresSolver : public IKSolver
     /**
      * \brief Compute joint target commands with damped least squares
      *
+     * A null space objective is only taken into account for more than six
+     * joints.
+     *
      * \param period The duration in sec for this simulation step
      * \param net_force The applied net force, expressed in the root frame
      *
-     * \return A point holding positions, velocities and accelerations of each joint
+     * \param control_cmd Preallocated buffer for resulting joint positions and velocities
      */
-    trajectory_msgs::JointTrajectoryPoint getJointControlCmds(
+    void getJointControlCmds(
         ros::Duration period,
-        const ctrl::Vector6D& net_force);
+        const ctrl::Vector6D& net_force,
+        KDL::JntArrayVel& control_cmd);
+
+    using IKSolver::getJointControlCmds;
 
     /**
      * \brief Initialize the solver
@@ -103,10 +111,47 @@ class DampedLeastSquaresSolver : public IKSolver
               const KDL::JntArray& lower_pos_limits);
 
   private:
-    std::shared_ptr<KDL::ChainJntToJacSolver> m_jnt_jacobian_solver;
-    KDL::Jacobian m_jnt_jacobian;
+    /**
+     * \brief Preallocated memory for the damped least squares solution
+     *
+     * \tparam Joints The number of joints, or Eigen::Dynamic if not known at compile time
+     */
+    template <int Joints>
+    struct Workspace
+    {
+      void resize(int joints)
+      {
+        jacobian.setZero(6, joints);
+        jnt_space_matrix.setZero(joints, joints);
+        jnt_space_ldlt = Eigen::LDLT<ctrl::MatrixN<Joints> >(joints);
+        jnt_torques.setZero(joints);
+      }
+
+      ctrl::Matrix6N<Joints>              jacobian;
+      ctrl::MatrixN<Joints>               jnt_space_matrix;
+      Eigen::LDLT<ctrl::MatrixN<Joints> > jnt_space_ldlt;
+      ctrl::VectorN<Joints>               jnt_torques;
+      ctrl::Matrix6D                      task_space_matrix;
+      Eigen::LDLT<ctrl::Matrix6D>         task_space_ldlt;
+      ctrl::Vector6D                      task_space_solution;
+    };
+
+    /**
+     * \brief Compute joint velocities with the damped least squares method
+     *
+     * \param net_force The applied net force, expressed in the root frame
+     * \param workspace Memory for the computation. Its size determines the kernel.
+     */
+    template <int Joints>
+    void computeJointVelocities(const ctrl::Vector6D& net_force, Workspace<Joints>& workspace);
+
     double m_alpha;
 
+    // Fixed-size kernels for the most common robots, dynamic ones for the rest
+    Workspace<6>              m_workspace_6;
+    Workspace<7>              m_workspace_7;
+    Workspace<Eigen::Dynamic> m_workspace;
+
     // IK solver specific dynamic reconfigure
     typedef cartesian_controller_base::DampedLeastSquaresSolverConfig
       IKConfig;
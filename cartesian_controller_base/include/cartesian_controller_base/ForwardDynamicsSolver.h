@@ -64,10 +64,7 @@
 #include <kdl/frames.hpp>
 #include <kdl/chain.hpp>
 #include <kdl/jacobian.hpp>
-#include <kdl/chainjnttojacsolver.hpp>
-#include <kdl/chaindynparam.hpp>
-#include <kdl/chainfksolverpos_recursive.hpp>
-#include <kdl/chainfksolvervel_recursive.hpp>
+#include <kdl/jntspaceinertiamatrix.hpp>
 
 namespace cartesian_controller_base{
 
@@ -102,11 +99,14 @@ class ForwardDynamicsSolver : public IKSolver
      * @param period The duration in sec for this simulation step
      * @param net_force The applied net force, expressed in the root frame
      *
-     * @return A point holding positions, velocities and accelerations of each joint
+     * @param control_cmd Preallocated buffer for resulting joint positions and velocities
      */
-    trajectory_msgs::JointTrajectoryPoint getJointControlCmds(
+    void getJointControlCmds(
         ros::Duration period,
-        const ctrl::Vector6D& net_force);
+        const ctrl::Vector6D& net_force,
+        KDL::JntArrayVel& control_cmd);
+
+    using IKSolver::getJointControlCmds;
 
     /**
      * @brief Initialize the solver
@@ -128,14 +128,73 @@ class ForwardDynamicsSolver : public IKSolver
     //! Build a generic robot model for control
     bool buildGenericModel();
 
+    /**
+     * @brief Compute the joint space inertia matrix of the generic model
+     *
+     * The generic model consists of point masses with isotropic rotational
+     * inertia at each segment's tip.  Instead of running KDL's general
+     * purpose composite inertia algorithm, this function takes the link
+     * frames and the Jacobian from \ref m_kinematics and sums each body's
+     * contribution \f$ m J_v^T J_v + i J_\omega^T J_\omega \f$ directly into
+     * \ref m_jnt_space_inertia.
+     */
+    void computeJntSpaceInertia();
+
+    /**
+     * @brief Preallocated memory for solving the equations of motion
+     *
+     * @tparam Joints The number of joints, or Eigen::Dynamic if not known at compile time
+     */
+    template <int Joints>
+    struct Workspace
+    {
+      void resize(int joints)
+      {
+        jacobian.setZero(6, joints);
+        jnt_space_inertia_llt = Eigen::LLT<ctrl::MatrixN<Joints> >(joints);
+        jnt_torques.setZero(joints);
+        inertia_jacobian.setZero(joints, 6);
+        jnt_null_space_accelerations.setZero(joints);
+      }
+
+      ctrl::Matrix6N<Joints>             jacobian;
+      Eigen::LLT<ctrl::MatrixN<Joints> > jnt_space_inertia_llt;
+      ctrl::VectorN<Joints>              jnt_torques;
+
+      // Null space projection
+      Eigen::Matrix<double, Joints, 6>   inertia_jacobian;  ///< \f$ H^{-1} J^T \f$
+      ctrl::Matrix6D                     task_space_matrix;
+      Eigen::LDLT<ctrl::Matrix6D>        task_space_ldlt;
+      ctrl::Vector6D                     task_space_solution;
+      ctrl::VectorN<Joints>              jnt_null_space_accelerations;
+    };
+
+    /**
+     * @brief Compute joint accelerations from the equations of motion
+     *
+     * @param net_force The applied net force, expressed in the root frame
+     * @param workspace Memory for the computation. Its size determines the kernel.
+     */
+    template <int Joints>
+    void computeJointAccelerations(const ctrl::Vector6D& net_force, Workspace<Joints>& workspace);
+
     // Forward dynamics
-    std::shared_ptr<KDL::ChainJntToJacSolver> m_jnt_jacobian_solver;
-    std::shared_ptr<KDL::ChainDynParam>       m_jnt_space_inertia_solver;
-    KDL::Jacobian                               m_jnt_jacobian;
     KDL::JntSpaceInertiaMatrix                  m_jnt_space_inertia;
 
+    // Workspace for the joint space inertia computation
+    Eigen::Matrix<double, 3, Eigen::Dynamic>    m_body_jacobian;
+
+    // Fixed-size kernels for the most common robots, dynamic ones for the rest
+    Workspace<6>                                m_workspace_6;
+    Workspace<7>                                m_workspace_7;
+    Workspace<Eigen::Dynamic>                   m_workspace;
+
+    //! The link mass that the current generic model was built with
+    double m_model_link_mass;
+
     // IK solver specific dynamic reconfigure
     std::atomic<double> m_min = 0.1;
+    std::atomic<double> m_null_space_damping = 0.1;
     typedef cartesian_controller_base::ForwardDynamicsSolverConfig
       IKConfig;
 
@@ -0,0 +1,228 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    HybridDampedLeastSquaresSolver.h
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef HYBRID_DAMPED_LEAST_SQUARES_SOLVER_H_INCLUDED
+#define HYBRID_DAMPED_LEAST_SQUARES_SOLVER_H_INCLUDED
+
+// Project
+#include <cartesian_controller_base/SelectivelyDampedLeastSquaresSolver.h>
+
+// Dynamic reconfigure
+#include <dynamic_reconfigure/server.h>
+#include <cartesian_controller_base/HybridDampedLeastSquaresSolverConfig.h>
+
+namespace cartesian_controller_base{
+
+  /**
+   * \brief A damped least squares IK solver that switches to SDLS near singularities
+   *
+   *  Away from singularities, this solves
+   *  \f$ \dot{q} = J^T ( J J^T + \lambda^2 I )^{-1} f \f$
+   *  like the \ref DampedLeastSquaresSolver, with the equivalent joint space
+   *  formulation for up to six joints.  The damping is not constant, but
+   *  adapts to the smallest singular value \f$ \sigma \f$ of \f$ J \f$:
+   *  \f$ \lambda^2 = (1 - (\sigma / \epsilon)^2) \lambda_{max}^2 \f$ for
+   *  \f$ \sigma < \epsilon \f$ and zero otherwise.  This avoids over-damping
+   *  in free space.
+   *
+   *  Close to singularities, i.e. once \f$ \sigma \f$ falls below
+   *  *sdls_threshold*, the solver switches to the more robust, but more
+   *  expensive \ref SelectivelyDampedLeastSquaresSolver.  It switches back
+   *  once \f$ \sigma \f$ clearly exceeds this threshold again.
+   *
+   *  There is no extra decomposition for estimating \f$ \sigma \f$.  The
+   *  Cholesky factorization of the undamped system, which the solver needs
+   *  anyway, bounds it by its smallest pivot and by one step of inverse
+   *  iteration per call.  The iteration starts from the last call's
+   *  direction, so the estimate gets accurate quickly when approaching a
+   *  singularity.  Without such a direction, e.g. after \ref setStartState
+   *  or \ref setState, the first call iterates until the mode is clear.
+   */
+class HybridDampedLeastSquaresSolver : public SelectivelyDampedLeastSquaresSolver
+{
+  public:
+    HybridDampedLeastSquaresSolver();
+    ~HybridDampedLeastSquaresSolver();
+
+    /**
+     * \brief Compute joint target commands with adaptive damping or SDLS
+     *
+     * A null space objective is taken into account for more than six joints,
+     * and in SDLS mode.
+     *
+     * \param period The duration in sec for this simulation step
+     * \param net_force The applied net force, expressed in the root frame
+     *
+     * \param control_cmd Preallocated buffer for resulting joint positions and velocities
+     */
+    void getJointControlCmds(
+        ros::Duration period,
+        const ctrl::Vector6D& net_force,
+        KDL::JntArrayVel& control_cmd);
+
+    using IKSolver::getJointControlCmds;
+
+    /**
+     * \brief Set initial joint configuration and derive the mode anew
+     */
+    bool setStartState(const std::vector<hardware_interface::JointHandle>& joint_handles);
+
+    /**
+     * \brief Take over the simulated joint state of another solver and derive the mode anew
+     */
+    void setState(const IKSolver& other);
+
+    /**
+     * \brief Remember the simulated state, the mode and the warm start
+     */
+    void saveState();
+
+    /**
+     * \brief Return to the state of the last \ref saveState
+     */
+    void restoreState();
+
+    /**
+     * \brief Initialize the solver
+     *
+     * \param nh A node handle for namespace-local parameter management
+     * \param chain The kinematic chain of the robot
+     * \param upper_pos_limits Tuple with max positive joint angles
+     * \param lower_pos_limits Tuple with max negative joint angles
+     *
+     * \return True, if everything went well
+     */
+    bool init(ros::NodeHandle& nh,
+              const KDL::Chain& chain,
+              const KDL::JntArray& upper_pos_limits,
+              const KDL::JntArray& lower_pos_limits);
+
+  private:
+    /**
+     * \brief Preallocated memory for the damped least squares solution
+     *
+     * The system matrix is \f$ J J^T \f$ for more than six joints and
+     * \f$ J^T J \f$ otherwise.
+     *
+     * \tparam Joints The number of joints, or Eigen::Dynamic if not known at compile time
+     */
+    template <int Joints>
+    struct DampedWorkspace
+    {
+      static constexpr int Size = (Joints == Eigen::Dynamic || Joints < 6) ? Joints : 6;
+
+      void resize(int joints)
+      {
+        const int size = std::min(joints, 6);
+        matrix.setZero(size, size);
+        ldlt = Eigen::LDLT<ctrl::MatrixN<Size> >(size);
+        rhs.setZero(size);
+        direction.setConstant(size, 1.0 / std::sqrt(size));
+        jnt_torques.setZero(joints);
+      }
+
+      ctrl::MatrixN<Size>                matrix;
+      Eigen::LDLT<ctrl::MatrixN<Size> >  ldlt;
+      ctrl::VectorN<Size>                rhs;
+      ctrl::VectorN<Size>                direction;  ///< Of the smallest singular value
+      ctrl::VectorN<Joints>              jnt_torques;
+    };
+
+    /**
+     * \brief Compute joint velocities with either method
+     *
+     * \param net_force The applied net force, expressed in the root frame
+     * \param workspace Memory for SDLS and the Jacobian. Its size determines the kernel.
+     * \param damped Memory for the damped least squares solution
+     */
+    template <int Joints>
+    void computeJointVelocities(const ctrl::Vector6D& net_force,
+                                Workspace<Joints>& workspace,
+                                DampedWorkspace<Joints>& damped);
+
+    /**
+     * \brief Estimate the smallest singular value from the factorized system
+     *
+     * Both estimates are upper bounds of the smallest eigenvalue of the
+     * system matrix, so the smaller one is taken.
+     *
+     * \return The estimate, or zero if the system is singular
+     */
+    template <int Joints>
+    double estimateSingularValue(DampedWorkspace<Joints>& damped);
+
+    //! The smallest singular value of the last SDLS decomposition
+    template <int Joints>
+    double getSelectiveSingularValue(const Workspace<Joints>& workspace) const;
+
+    //! Forget the mode and the warm start, e.g. for a new joint state
+    void resetMode();
+
+    //! Inverse iterations of the first estimate after \ref resetMode
+    static constexpr int COLD_START_ITERATIONS = 10;
+
+    double m_damping_threshold;  ///< \f$ \epsilon \f$
+    double m_max_damping;        ///< \f$ \lambda_{max} \f$
+    double m_sdls_threshold;
+    double m_singular_value;     ///< Of the last step
+    bool   m_selective_damping;  ///< Whether to use SDLS
+    bool   m_cold_start;         ///< Whether the next estimate has no warm start
+
+    DampedWorkspace<6>              m_damped_6;
+    DampedWorkspace<7>              m_damped_7;
+    DampedWorkspace<Eigen::Dynamic> m_damped;
+
+    // State of the last saveState()
+    double         m_saved_singular_value;
+    bool           m_saved_selective_damping;
+    bool           m_saved_cold_start;
+    ctrl::VectorND m_saved_direction;
+
+    // IK solver specific dynamic reconfigure
+    typedef cartesian_controller_base::HybridDampedLeastSquaresSolverConfig
+      IKConfig;
+
+    void dynamicReconfigureCallback(IKConfig& config, uint32_t level);
+
+    std::shared_ptr<dynamic_reconfigure::Server<IKConfig> > m_dyn_conf_server;
+    dynamic_reconfigure::Server<IKConfig>::CallbackType m_callback_type;
+};
+
+}
+
+#endif
@@ -43,6 +43,9 @@
 
 // Project
 #include <cartesian_controller_base/Utility.h>
+#include <cartesian_controller_base/KinematicsCache.h>
+#include <cartesian_controller_base/NullSpaceObjective.h>
+#include <cartesian_controller_base/StageTimer.h>
 
 // ros_controls
 #include <hardware_interface/joint_command_interface.h>
@@ -50,8 +53,11 @@
 // ros general
 #include <ros/ros.h>
 #include <trajectory_msgs/JointTrajectoryPoint.h>
+#include <pluginlib/class_loader.h>
 
 // other
+#include <atomic>
+#include <string>
 #include <vector>
 #include <memory>
 
@@ -59,10 +65,7 @@
 #include <kdl/frames.hpp>
 #include <kdl/chain.hpp>
 #include <kdl/jacobian.hpp>
-#include <kdl/chainjnttojacsolver.hpp>
-#include <kdl/chaindynparam.hpp>
-#include <kdl/chainfksolverpos_recursive.hpp>
-#include <kdl/chainfksolvervel_recursive.hpp>
+#include <kdl/jntarrayvel.hpp>
 
 namespace cartesian_controller_base{
 
@@ -81,16 +84,33 @@ class IKSolver
      * @brief Compute joint target commands, using specific IK algorithms
      *
      * The resulting motion will be forwarded as reference to the low-level
-     * joint control.
+     * joint control.  Implementations write into the given buffer, which is
+     * expected to be sized to the number of joints.  This function must not
+     * allocate, since it is called in the realtime update loop.
      *
      * @param period The duration in sec for this simulation step
      * @param net_force The applied net force, expressed in the root frame
+     * @param control_cmd Preallocated buffer for resulting joint positions and velocities
+     */
+    virtual void getJointControlCmds(
+        ros::Duration period,
+        const ctrl::Vector6D& net_force,
+        KDL::JntArrayVel& control_cmd) = 0;
+
+    /**
+     * @brief Compute joint target commands, using specific IK algorithms
      *
-     * @return A point holding positions, velocities and accelerations of each joint
+     * Convenience wrapper for the function above.  It allocates a new message
+     * in each call and should therefore not be used in realtime contexts.
+     *
+     * @param period The duration in sec for this simulation step
+     * @param net_force The applied net force, expressed in the root frame
+     *
+     * @return A point holding positions and velocities of each joint
      */
-    virtual trajectory_msgs::JointTrajectoryPoint getJointControlCmds(
+    trajectory_msgs::JointTrajectoryPoint getJointControlCmds(
         ros::Duration period,
-        const ctrl::Vector6D& net_force) = 0;
+        const ctrl::Vector6D& net_force);
 
     /**
      * @brief Get the current end effector pose of the simulated robot
@@ -122,8 +142,33 @@ class IKSolver
      */
     const KDL::JntArray& getPositions() const;
 
-    //! Set initial joint configuration
-    bool setStartState(const std::vector<hardware_interface::JointHandle>& joint_handles);
+    /**
+     * @brief Get the kinematics of the simulated robot
+     *
+     * The kinematics are brought up to date with the current joint positions
+     * if necessary.  Use this to look up link frames without computing
+     * forward kinematics anew.
+     *
+     * @return Frames and Jacobian of the current joint state
+     */
+    const KinematicsCache& getKinematics();
+
+    /**
+     * @brief Resolve a link name into its segment index in the solver's chain
+     *
+     * Unlike \ref getKinematics, this leaves the kinematics alone and may be
+     * called from other threads than the control loop.
+     *
+     * @see KinematicsCache::getSegmentIndex
+     */
+    int getSegmentIndex(const std::string& name) const;
+
+    /**
+     * @brief Set initial joint configuration
+     *
+     * Derived solvers that keep further state between steps reset it.
+     */
+    virtual bool setStartState(const std::vector<hardware_interface::JointHandle>& joint_handles);
 
     /**
      * @brief Synchronize joint positions with the real robot
@@ -136,6 +181,46 @@ class IKSolver
      */
     void synchronizeJointPositions(const std::vector<hardware_interface::JointHandle>& joint_handles);
 
+    /**
+     * @brief Synchronize joint positions with a snapshot of the real robot
+     *
+     * Use this if the handles may change meanwhile, e.g. when not called
+     * from the controller's update().
+     *
+     * @param positions The joint positions of the real robot
+     */
+    void synchronizeJointPositions(const KDL::JntArray& positions);
+
+    /**
+     * @brief Take over the simulated joint state of another solver
+     *
+     * Use this to switch between solvers of the same chain without a jump in
+     * the simulated robot's motion.  Both solvers must be initialized with
+     * the same chain.  Realtime safe.
+     *
+     * Derived solvers that keep further state between steps reset it.
+     *
+     * @param other The solver whose joint positions, velocities and
+     * accelerations to copy
+     */
+    virtual void setState(const IKSolver& other);
+
+    /**
+     * @brief Remember the current simulated state
+     *
+     * Use this together with \ref restoreState to simulate a few steps
+     * ahead without committing them.  Derived solvers that keep further
+     * state between steps save it in addition.  Realtime safe.
+     */
+    virtual void saveState();
+
+    /**
+     * @brief Return to the state of the last \ref saveState
+     *
+     * Realtime safe.
+     */
+    virtual void restoreState();
+
     /**
      * @brief Initialize the solver
      *
@@ -159,8 +244,50 @@ class IKSolver
      */
     void updateKinematics();
 
+    //! True, if a null space objective has been configured
+    bool hasNullSpaceObjective() const;
+
+    /**
+     * @brief Measure the execution time of the null space objective
+     *
+     * The time is part of the solver's own execution time.
+     *
+     * @param timings Where to record each step's duration. Pass nullptr to
+     * stop measuring.
+     */
+    void setNullSpaceTimings(StageStatistics* timings);
+
+    /**
+     * @brief Take joints at their limits out of the IK problem
+     *
+     * By default, joint positions are only clamped to their limits after
+     * each step.  In limit-aware mode, joints that the solver would push
+     * further into their limits are removed from the next step's Jacobian,
+     * so that the remaining joints take over the Cartesian motion.
+     * Thread-safe.
+     *
+     * @param limit_aware True to enable, false for clamping only
+     */
+    void setLimitAware(bool limit_aware);
+
   protected:
 
+    /**
+     * @brief Compute the null space objective's motion for this step
+     *
+     * Derived solvers call this after updating \ref m_kinematics, so that
+     * the objective can reuse the Jacobian.  The motion is stored in \ref
+     * m_null_space_motion.  Solvers then project it into the null space of
+     * the Jacobian, reusing their own decompositions of this step, and
+     * finish with \ref endNullSpaceMotion.
+     *
+     * @return False, if there is no objective. Then there is nothing to project.
+     */
+    bool beginNullSpaceMotion();
+
+    //! Finish the objective's time measurement
+    void endNullSpaceMotion();
+
     /**
      * @brief Make sure positions stay in allowed margins
      *
@@ -171,6 +298,38 @@ class IKSolver
      */
     void applyJointLimits();
 
+    /**
+     * @brief Find the joints that can't follow the net force
+     *
+     * A joint is saturated if it is at one of its limits and the joint
+     * torques \f$ J^T f \f$ push it further into this limit.  These are the
+     * active bounds of minimizing the Cartesian error.  Derived solvers call
+     * this after updating \ref m_kinematics and remove the saturated joints
+     * with \ref deactivateSaturatedJoints.
+     *
+     * @param net_force The applied net force, expressed in the root frame
+     *
+     * @return True, if limit-aware mode is enabled and any joint is saturated
+     */
+    bool updateSaturatedJoints(const ctrl::Vector6D& net_force);
+
+    /**
+     * @brief Zero the Jacobian columns of saturated joints
+     *
+     * @param jacobian A copy of the Jacobian of this step
+     */
+    template <class Matrix>
+    void deactivateSaturatedJoints(Eigen::MatrixBase<Matrix>& jacobian) const
+    {
+      for (int i = 0; i < m_number_joints; ++i)
+      {
+        if (m_saturated_joints[i])
+        {
+          jacobian.col(i).setZero();
+        }
+      }
+    }
+
     //! The underlying physical system
     KDL::Chain m_chain;
 
@@ -187,14 +346,37 @@ class IKSolver
     // Joint limits
     KDL::JntArray m_upper_pos_limits;
     KDL::JntArray m_lower_pos_limits;
+    std::vector<bool> m_continuous_joints;  ///< Determined once in init()
+    std::vector<bool> m_saturated_joints;   ///< Of the current step
+    std::atomic<bool> m_limit_aware;
 
-    // Forward kinematics
-    std::shared_ptr<
-      KDL::ChainFkSolverPos_recursive>  m_fk_pos_solver;
-    std::shared_ptr<
-      KDL::ChainFkSolverVel_recursive>  m_fk_vel_solver;
+    /**
+     * Forward kinematics and Jacobian of the chain, computed in one pass.
+     * Derived solvers should call update() with \ref m_current_positions
+     * before using the Jacobian.
+     */
+    KinematicsCache                     m_kinematics;
     KDL::Frame                          m_end_effector_pose;
     ctrl::Vector6D                      m_end_effector_vel;
+
+    //! The objective's motion in this step, before projection
+    ctrl::VectorND                      m_null_space_motion;
+
+  private:
+    // The loader must outlive the objective
+    std::shared_ptr<pluginlib::ClassLoader<NullSpaceObjective> > m_null_space_loader;
+    std::shared_ptr<NullSpaceObjective>                          m_null_space_objective;
+
+    StageStatistics*                      m_null_space_timings;
+    std::chrono::steady_clock::time_point m_null_space_start;
+
+    // Joint state of the last saveState()
+    KDL::JntArray m_saved_positions;
+    KDL::JntArray m_saved_velocities;
+    KDL::JntArray m_saved_accelerations;
+    KDL::JntArray m_saved_last_positions;
+    KDL::JntArray m_saved_last_velocities;
+    std::vector<bool> m_saved_saturated_joints;
 };
 
 
@@ -74,11 +74,14 @@ class JacobianTransposeSolver : public IKSolver
      * \param period The duration in sec for this simulation step
      * \param net_force The applied net force, expressed in the root frame
      *
-     * \return A point holding positions, velocities and accelerations of each joint
+     * \param control_cmd Preallocated buffer for resulting joint positions and velocities
      */
-    trajectory_msgs::JointTrajectoryPoint getJointControlCmds(
+    void getJointControlCmds(
         ros::Duration period,
-        const ctrl::Vector6D& net_force);
+        const ctrl::Vector6D& net_force,
+        KDL::JntArrayVel& control_cmd);
+
+    using IKSolver::getJointControlCmds;
 
     /**
      * \brief Initialize the solver
@@ -96,8 +99,13 @@ class JacobianTransposeSolver : public IKSolver
               const KDL::JntArray& lower_pos_limits);
 
   private:
-    std::shared_ptr<KDL::ChainJntToJacSolver> m_jnt_jacobian_solver;
-    KDL::Jacobian m_jnt_jacobian;
+    //! The Jacobian without saturated joints
+    ctrl::Matrix6N<Eigen::Dynamic> m_active_jacobian;
+
+    // Null space projection
+    ctrl::Matrix6D              m_task_space_matrix;
+    Eigen::LDLT<ctrl::Matrix6D> m_task_space_ldlt;
+    ctrl::Vector6D              m_task_space_solution;
 };
 
 }
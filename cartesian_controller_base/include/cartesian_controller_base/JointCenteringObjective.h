@@ -0,0 +1,76 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    JointCenteringObjective.h
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef JOINT_CENTERING_OBJECTIVE_H_INCLUDED
+#define JOINT_CENTERING_OBJECTIVE_H_INCLUDED
+
+// Project
+#include <cartesian_controller_base/NullSpaceObjective.h>
+
+namespace cartesian_controller_base{
+
+/*! \brief Keep joints close to the middle of their position limits
+ *
+ *  The joint motion is the negative gradient of
+ *  \f$ \frac{1}{2} \sum_i \left( \frac{q_i - \bar{q}_i}{q_{i,max} - q_{i,min}} \right)^2 \f$
+ *  where \f$ \bar{q}_i \f$ is the middle of joint i's range.  Continuous
+ *  joints and joints without limits are left alone.
+ */
+class JointCenteringObjective : public NullSpaceObjective
+{
+  public:
+    JointCenteringObjective();
+    ~JointCenteringObjective();
+
+    bool init(ros::NodeHandle& nh,
+              const KDL::Chain& chain,
+              const KDL::JntArray& upper_pos_limits,
+              const KDL::JntArray& lower_pos_limits);
+
+    void computeMotion(const KDL::JntArray& positions,
+                       const KDL::Jacobian& jacobian,
+                       ctrl::VectorND& motion);
+
+  private:
+    ctrl::VectorND m_center;
+    ctrl::VectorND m_weights;  ///< Zero for joints to leave alone
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    JointPreviewInterface.h
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef JOINT_PREVIEW_INTERFACE_H_INCLUDED
+#define JOINT_PREVIEW_INTERFACE_H_INCLUDED
+
+// ros_controls
+#include <hardware_interface/internal/hardware_resource_manager.h>
+
+// Other
+#include <cstddef>
+#include <string>
+
+namespace cartesian_controller_base
+{
+
+/**
+ * @brief Predicted commands of one joint for the next control cycles
+ *
+ * The robot hardware owns the buffers and sizes them once to the longest
+ * horizon that its drives can use.  Controllers write step \a k with what they
+ * expect to command \a k + 1 control cycles after the current one.  Drives with
+ * trajectory buffers can use this to track more smoothly, e.g. with a
+ * lookahead.  The current command goes to the regular joint handle as usual.
+ */
+class JointPreviewHandle
+{
+  public:
+    JointPreviewHandle() = default;
+
+    /**
+     * @param name The joint's name
+     * @param positions Buffer for \a horizon predicted positions
+     * @param velocities Buffer for \a horizon predicted velocities
+     * @param horizon The number of predicted steps
+     */
+    JointPreviewHandle(const std::string& name, double* positions, double* velocities, size_t horizon)
+      : m_name(name), m_positions(positions), m_velocities(velocities), m_horizon(horizon)
+    {
+      if (!positions || !velocities)
+      {
+        throw hardware_interface::HardwareInterfaceException(
+          "Cannot create handle '" + name + "'. Preview data pointer is null.");
+      }
+    }
+
+    std::string getName() const { return m_name; }
+
+    //! The number of steps that the buffers hold
+    size_t getHorizon() const { return m_horizon; }
+
+    void setPosition(size_t step, double position) { m_positions[step] = position; }
+    void setVelocity(size_t step, double velocity) { m_velocities[step] = velocity; }
+
+    double getPosition(size_t step) const { return m_positions[step]; }
+    double getVelocity(size_t step) const { return m_velocities[step]; }
+
+  private:
+    std::string m_name;
+    double*     m_positions   = nullptr;
+    double*     m_velocities  = nullptr;
+    size_t      m_horizon     = 0;
+};
+
+/**
+ * @brief Hardware interface for predicted joint commands
+ *
+ * Register one \ref JointPreviewHandle per joint in your RobotHW.  The
+ * handles are not claimed, so they come in addition to a joint command
+ * interface.
+ */
+class JointPreviewInterface : public hardware_interface::HardwareResourceManager<JointPreviewHandle>
+{
+};
+
+}
+
+#endif
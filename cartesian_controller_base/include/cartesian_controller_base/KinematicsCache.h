@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    KinematicsCache.h
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef KINEMATICS_CACHE_H_INCLUDED
+#define KINEMATICS_CACHE_H_INCLUDED
+
+// KDL
+#include <kdl/chain.hpp>
+#include <kdl/frames.hpp>
+#include <kdl/jacobian.hpp>
+#include <kdl/jntarray.hpp>
+
+// other
+#include <string>
+#include <vector>
+
+namespace cartesian_controller_base{
+
+/*! \brief Forward kinematics of a chain in one recursive pass
+ *
+ *  This class computes all link frames and the joint Jacobian of a kinematic
+ *  chain together, in a single walk from the chain's root to its tip.  The
+ *  results are kept until the joint positions change, so that repeated
+ *  queries for the same joint state are for free.
+ *
+ *  All quantities are expressed in the chain's root frame.  The Jacobian
+ *  uses the tip of the last segment as reference point, which is consistent
+ *  with KDL::ChainJntToJacSolver.
+ */
+class KinematicsCache
+{
+  public:
+    KinematicsCache();
+    ~KinematicsCache();
+
+    /**
+     * @brief Initialize the cache for the given chain
+     *
+     * @param chain The kinematic chain of the robot
+     */
+    void init(const KDL::Chain& chain);
+
+    /**
+     * @brief Compute the kinematics for the given joint positions
+     *
+     * This function does nothing if the positions are identical to those of
+     * the last update. It does not allocate.
+     *
+     * @param positions The joint positions of the chain
+     *
+     * @return True, if the kinematics have been recomputed
+     */
+    bool update(const KDL::JntArray& positions);
+
+    /**
+     * @brief Get the pose of the chain's last segment
+     *
+     * @return The end effector pose with respect to the chain's root
+     */
+    const KDL::Frame& getEndEffectorPose() const;
+
+    /**
+     * @brief Get the joint Jacobian
+     *
+     * @return The Jacobian with the end effector as reference point
+     */
+    const KDL::Jacobian& getJacobian() const;
+
+    /**
+     * @brief Get the index of a segment with the given name
+     *
+     * @param name The segment's name, which is the name of its URDF child link
+     *
+     * @return The index, or -1 if the chain has no such segment
+     */
+    int getSegmentIndex(const std::string& name) const;
+
+    /**
+     * @brief Get the pose of a segment's tip
+     *
+     * @param index The segment's index in the chain. Negative values denote the
+     * chain's root.
+     *
+     * @return The segment's pose with respect to the chain's root
+     */
+    const KDL::Frame& getSegmentFrame(int index) const;
+
+    /**
+     * @brief Get the pose of a segment's tip
+     *
+     * Convenience overload that looks up the segment by name.  Unknown names
+     * are treated as the chain's root, i.e. the identity is returned.
+     *
+     * @param name The segment's name, which is the name of its URDF child link
+     *
+     * @return The segment's pose with respect to the chain's root
+     */
+    const KDL::Frame& getSegmentFrame(const std::string& name) const;
+
+  private:
+    KDL::Chain                m_chain;
+    KDL::JntArray             m_positions;
+    std::vector<KDL::Frame>   m_segment_frames;
+    KDL::Jacobian             m_jacobian;
+    KDL::Frame                m_root;
+    bool                      m_valid;
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    ManipulabilityObjective.h
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef MANIPULABILITY_OBJECTIVE_H_INCLUDED
+#define MANIPULABILITY_OBJECTIVE_H_INCLUDED
+
+// Project
+#include <cartesian_controller_base/NullSpaceObjective.h>
+
+namespace cartesian_controller_base{
+
+/*! \brief Stay away from singularities
+ *
+ *  The joint motion is the gradient of Yoshikawa's manipulability measure
+ *  \f$ w = \sqrt{\det(J J^T)} \f$.  Its partial derivatives are
+ *  \f$ \frac{\partial w}{\partial q_i} = w \, \mathrm{tr} \left( (J J^T)^{-1}
+ *  \frac{\partial J}{\partial q_i} J^T \right) \f$.
+ *  The derivatives of the Jacobian follow from the Jacobian itself:
+ *  With \f$ v_k \f$ and \f$ \omega_k \f$ denoting the linear and
+ *  angular parts of column k, column k of \f$ \frac{\partial J}{\partial q_i}
+ *  \f$ is \f$ (\omega_i \times v_k, \omega_i \times \omega_k) \f$ for
+ *  \f$ i \le k \f$ and \f$ (\omega_k \times v_i, 0) \f$ otherwise.
+ *  So this needs no further kinematics computations.
+ */
+class ManipulabilityObjective : public NullSpaceObjective
+{
+  public:
+    ManipulabilityObjective();
+    ~ManipulabilityObjective();
+
+    bool init(ros::NodeHandle& nh,
+              const KDL::Chain& chain,
+              const KDL::JntArray& upper_pos_limits,
+              const KDL::JntArray& lower_pos_limits);
+
+    void computeMotion(const KDL::JntArray& positions,
+                       const KDL::Jacobian& jacobian,
+                       ctrl::VectorND& motion);
+
+  private:
+    ctrl::Matrix6D                m_jjt;
+    Eigen::LDLT<ctrl::Matrix6D>   m_jjt_ldlt;
+    Eigen::Matrix<double, 6, Eigen::Dynamic> m_jjt_inv_j;  ///< \f$ (J J^T)^{-1} J \f$
+};
+
+} // namespace
+
+#endif
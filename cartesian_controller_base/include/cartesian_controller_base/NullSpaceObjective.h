@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    NullSpaceObjective.h
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef NULL_SPACE_OBJECTIVE_H_INCLUDED
+#define NULL_SPACE_OBJECTIVE_H_INCLUDED
+
+// Project
+#include <cartesian_controller_base/Utility.h>
+
+// ros general
+#include <ros/ros.h>
+
+// KDL
+#include <kdl/chain.hpp>
+#include <kdl/jacobian.hpp>
+#include <kdl/jntarray.hpp>
+
+namespace cartesian_controller_base{
+
+/*! \brief Base class for secondary objectives in the null space of the IK solvers
+ *
+ *  Redundant manipulators can follow a Cartesian target with infinitely many
+ *  joint configurations.  A null space objective chooses among them, e.g. to
+ *  stay away from joint limits or singularities.  IK solvers project the
+ *  objective's joint motion into the null space of the Jacobian, so that it
+ *  doesn't disturb the Cartesian motion.
+ *
+ *  Implementations get the Jacobian that the IK solver has already
+ *  computed for the current step.
+ */
+class NullSpaceObjective
+{
+  public:
+    NullSpaceObjective();
+    virtual ~NullSpaceObjective();
+
+    /**
+     * \brief Initialize the objective
+     *
+     * \param nh A node handle in the objective's namespace
+     * \param chain The kinematic chain of the robot
+     * \param upper_pos_limits Tuple with max positive joint angles
+     * \param lower_pos_limits Tuple with max negative joint angles
+     *
+     * \return True, if everything went well
+     */
+    virtual bool init(ros::NodeHandle& nh,
+                      const KDL::Chain& chain,
+                      const KDL::JntArray& upper_pos_limits,
+                      const KDL::JntArray& lower_pos_limits);
+
+    /**
+     * \brief Compute the joint motion that improves the objective
+     *
+     * Called in the realtime loop, so this must not allocate.
+     *
+     * \param positions The current joint positions
+     * \param jacobian The joint Jacobian at these positions
+     * \param motion Preallocated buffer for the resulting joint motion, sized
+     * to the number of joints. Solvers interpret this as velocities or as
+     * torques, depending on their formulation.
+     */
+    virtual void computeMotion(const KDL::JntArray& positions,
+                               const KDL::Jacobian& jacobian,
+                               ctrl::VectorND& motion) = 0;
+
+  protected:
+    //! Scales the objective's motion
+    double m_gain;
+};
+
+} // namespace
+
+#endif
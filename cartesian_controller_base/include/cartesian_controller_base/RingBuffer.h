@@ -0,0 +1,165 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    RingBuffer.h
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef RING_BUFFER_H_INCLUDED
+#define RING_BUFFER_H_INCLUDED
+
+// Other
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace cartesian_controller_base
+{
+
+/**
+ * @brief A lock-free queue from one non-realtime to one realtime thread
+ *
+ * In contrast to \ref TripleBuffer, this keeps every value in the order of
+ * writing, until the reader pops it.  The reader may look at all values in
+ * the queue before deciding what to pop.  The capacity is fixed on \ref init,
+ * so neither side allocates afterwards, given that copying \a T doesn't.
+ *
+ * @tparam T The data to hand over. Must be copy-assignable.
+ */
+template <class T>
+class RingBuffer
+{
+  public:
+    RingBuffer()
+      : m_head(0), m_tail(0)
+    {
+    }
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    /**
+     * @brief Allocate space for a number of values
+     *
+     * Call this once before using the buffer from either side.
+     *
+     * @param capacity The maximal number of values in the queue
+     */
+    void init(size_t capacity)
+    {
+      m_slots.resize(capacity + 1);  // One slot tells full from empty
+      m_head = 0;
+      m_tail = 0;
+    }
+
+    /**
+     * @brief Append a value on the non-realtime side
+     *
+     * Call this from one thread only.
+     *
+     * @param data The value to append
+     *
+     * @return False if the queue is full. The value is dropped then.
+     */
+    bool push(const T& data)
+    {
+      const size_t head = m_head.load(std::memory_order_relaxed);
+      const size_t next = increment(head);
+      if (next == m_tail.load(std::memory_order_acquire))
+      {
+        return false;
+      }
+      m_slots[head] = data;
+      m_head.store(next, std::memory_order_release);
+      return true;
+    }
+
+    /**
+     * @brief The number of values that the reader can access
+     *
+     * Call this and the functions below from the realtime thread only.
+     * The size only ever grows between calls to \ref pop.
+     */
+    size_t size() const
+    {
+      const size_t head = m_head.load(std::memory_order_acquire);
+      const size_t tail = m_tail.load(std::memory_order_relaxed);
+      return head >= tail ? head - tail : head + m_slots.size() - tail;
+    }
+
+    /**
+     * @brief Access a value in the queue
+     *
+     * @param i The position in the queue, starting with zero for the oldest
+     * value. Must be less than \ref size.
+     */
+    const T& operator[](size_t i) const
+    {
+      const size_t index = m_tail.load(std::memory_order_relaxed) + i;
+      return m_slots[index < m_slots.size() ? index : index - m_slots.size()];
+    }
+
+    /**
+     * @brief Remove the oldest value
+     *
+     * The queue must not be empty.
+     */
+    void pop()
+    {
+      m_tail.store(increment(m_tail.load(std::memory_order_relaxed)), std::memory_order_release);
+    }
+
+    /**
+     * @brief Remove all values that are currently in the queue
+     */
+    void clear()
+    {
+      m_tail.store(m_head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+  private:
+    size_t increment(size_t index) const
+    {
+      return index + 1 < m_slots.size() ? index + 1 : 0;
+    }
+
+    std::vector<T> m_slots;
+
+    alignas(64) std::atomic<size_t> m_head;  ///< Owned by the writer
+    alignas(64) std::atomic<size_t> m_tail;  ///< Owned by the reader
+};
+
+}
+
+#endif
@@ -0,0 +1,162 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    RobotModelRegistry.h
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef ROBOT_MODEL_REGISTRY_H_INCLUDED
+#define ROBOT_MODEL_REGISTRY_H_INCLUDED
+
+// ROS
+#include <ros/node_handle.h>
+
+// KDL
+#include <kdl/chain.hpp>
+#include <kdl/jntarray.hpp>
+#include <kdl/tree.hpp>
+
+// URDF
+#include <urdf/model.h>
+
+// Other
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cartesian_controller_base
+{
+
+/**
+ * @brief A parsed robot description
+ *
+ * Instances are immutable and shared between all controllers that use the
+ * same robot description.  Get them from \ref RobotModelRegistry.
+ */
+class RobotModel
+{
+  public:
+    /**
+     * @brief Parse a robot description
+     *
+     * @param robot_description The robot's URDF as string
+     *
+     * @return True, if both the URDF model and the KDL tree could be built
+     */
+    bool init(const std::string& robot_description);
+
+    /**
+     * @brief Extract a kinematic chain
+     *
+     * @param root The first link of the chain
+     * @param tip The last link of the chain
+     * @param chain The resulting chain
+     *
+     * @return True, if both links exist and are connected
+     */
+    bool getChain(const std::string& root, const std::string& tip, KDL::Chain& chain) const;
+
+    /**
+     * @brief Get the position limits of joints
+     *
+     * Continuous joints get NaN limits.  Joints without limits in the URDF
+     * get zero limits.
+     *
+     * @param joints The names of the joints
+     * @param upper_pos_limits Upper limits, resized to the number of joints
+     * @param lower_pos_limits Lower limits, resized to the number of joints
+     *
+     * @return False, if one of the joints does not exist
+     */
+    bool getJointLimits(const std::vector<std::string>& joints,
+                        KDL::JntArray& upper_pos_limits,
+                        KDL::JntArray& lower_pos_limits) const;
+
+    const urdf::Model& getURDF() const { return m_model; }
+    const KDL::Tree& getTree() const { return m_tree; }
+
+  private:
+    urdf::Model m_model;
+    KDL::Tree   m_tree;
+};
+
+/**
+ * @brief Process-wide cache of parsed robot descriptions
+ *
+ * Parsing a large URDF and building its KDL tree can take seconds.  All
+ * controllers in the same process that use the same robot description share
+ * one parsed model through this registry.  Models are identified by a hash of
+ * their description and parsed on first request.
+ *
+ * All functions are thread-safe, but not realtime safe.
+ */
+class RobotModelRegistry
+{
+  public:
+    /**
+     * @brief Get the parsed model of a robot description
+     *
+     * @param robot_description The robot's URDF as string
+     *
+     * @return The shared model, or nullptr if the description is invalid
+     */
+    static std::shared_ptr<const RobotModel> get(const std::string& robot_description);
+
+    /**
+     * @brief Get the parsed model of the \a robot_description parameter
+     *
+     * The parameter is searched in the enclosing namespaces of the node.
+     *
+     * @param nh A node handle for parameter access
+     *
+     * @return The shared model, or nullptr if something went wrong
+     */
+    static std::shared_ptr<const RobotModel> load(const ros::NodeHandle& nh);
+
+  private:
+    struct Entry
+    {
+      std::string description;
+      std::shared_ptr<const RobotModel> model;
+    };
+
+    static std::mutex                     m_mutex;
+    static std::multimap<size_t, Entry>   m_models;
+};
+
+}
+
+#endif
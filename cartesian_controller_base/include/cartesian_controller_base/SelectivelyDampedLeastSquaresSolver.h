@@ -80,11 +80,14 @@ class SelectivelyDampedLeastSquaresSolver : public IKSolver
      * \param period The duration in sec for this simulation step
      * \param net_force The applied net force, expressed in the root frame
      *
-     * \return A point holding positions, velocities and accelerations of each joint
+     * \param control_cmd Preallocated buffer for resulting joint positions and velocities
      */
-    trajectory_msgs::JointTrajectoryPoint getJointControlCmds(
+    void getJointControlCmds(
         ros::Duration period,
-        const ctrl::Vector6D& net_force);
+        const ctrl::Vector6D& net_force,
+        KDL::JntArrayVel& control_cmd);
+
+    using IKSolver::getJointControlCmds;
 
     /**
      * \brief Initialize the solver
@@ -101,23 +104,75 @@ class SelectivelyDampedLeastSquaresSolver : public IKSolver
               const KDL::JntArray& upper_pos_limits,
               const KDL::JntArray& lower_pos_limits);
 
-  private:
+  protected:
     /**
-     * @brief Helper function to clamp a column vector
+     * @brief Helper function to clamp a column vector in place
      *
      * This literally implements ClampMaxAbs() from Buss' and Kim's paper.
      *
      * @param w The vector to clamp
      * @param d The threshold for the max allowed value
+     */
+    template <class Vector>
+    void clampMaxAbs(Eigen::MatrixBase<Vector>& w, double d);
+
+    /**
+     * @brief Preallocated memory for the decomposition and the intermediate results
+     *
+     * @tparam Joints The number of joints, or Eigen::Dynamic if not known at compile time
+     */
+    template <int Joints>
+    struct Workspace
+    {
+      void resize(int joints)
+      {
+        jacobian.setZero(6, joints);
+        jacobian_transpose_u.setZero(joints, 6);
+        rho.setZero(joints);
+        phi.setZero(joints);
+        sum_phi.setZero(joints);
+      }
+
+      ctrl::Matrix6N<Joints>                          jacobian;
+      Eigen::SelfAdjointEigenSolver<ctrl::Matrix6D>   eigen_solver;
+      Eigen::Matrix<double, Joints, 6>                jacobian_transpose_u;
+      ctrl::VectorN<Joints>                           rho;
+      ctrl::VectorN<Joints>                           phi;
+      ctrl::VectorN<Joints>                           sum_phi;
+    };
+
+    /**
+     * @brief Compute joint velocities with the SDLS method
      *
-     * @return The clamped vector
+     * Instead of a full SVD of the Jacobian J, this decomposes the symmetric
+     * 6x6 matrix J J^T into U S^2 U^T and recovers the right singular vectors
+     * with V_i = J^T U_i / s_i.  Its size does not depend on the number of
+     * joints.  Singular values that vanish numerically are skipped, since
+     * their contribution is damped to zero anyway.
+     *
+     * @param net_force The applied net force, expressed in the root frame
+     * @param workspace Memory for the computation. Its size determines the kernel.
      */
-    Eigen::Matrix<double, Eigen::Dynamic, 1>
-    clampMaxAbs(const Eigen::Matrix<double, Eigen::Dynamic, 1>& w, double d);
+    template <int Joints>
+    void computeJointVelocities(const ctrl::Vector6D& net_force, Workspace<Joints>& workspace);
 
-    std::shared_ptr<KDL::ChainJntToJacSolver> m_jnt_jacobian_solver;
-    KDL::Jacobian m_jnt_jacobian;
+    /**
+     * @brief The SDLS method on an already prepared Jacobian
+     *
+     * This is \ref computeJointVelocities without copying the Jacobian and
+     * removing saturated joints, for solvers that have done so already.
+     * Instantiated for 6, 7 and Eigen::Dynamic joints.
+     *
+     * @param net_force The applied net force, expressed in the root frame
+     * @param workspace Memory for the computation, with the Jacobian of this step
+     */
+    template <int Joints>
+    void solveSelectivelyDamped(const ctrl::Vector6D& net_force, Workspace<Joints>& workspace);
 
+    // Fixed-size kernels for the most common robots, dynamic ones for the rest
+    Workspace<6>              m_workspace_6;
+    Workspace<7>              m_workspace_7;
+    Workspace<Eigen::Dynamic> m_workspace;
 };
 
 }
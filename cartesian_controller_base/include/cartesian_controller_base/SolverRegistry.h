@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    SolverRegistry.h
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef SOLVER_REGISTRY_H_INCLUDED
+#define SOLVER_REGISTRY_H_INCLUDED
+
+// Project
+#include <cartesian_controller_base/IKSolver.h>
+
+// ROS
+#include <ros/time.h>
+
+// Other
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cartesian_controller_base
+{
+
+/**
+ * @brief The simulated motion of a chain, handed from one controller to the next
+ *
+ * The controller manager stops and starts controllers in its realtime
+ * thread, so this is only accessed from there, except for releasing the
+ * solver.  Both only store a pointer, such that no reference counts change
+ * in the realtime thread.  Controllers release their solvers from the slot
+ * when they are destroyed, which the controller manager never does during
+ * a switch.
+ */
+struct SolverHandover
+{
+  std::atomic<const IKSolver*> solver{nullptr};  ///< Of the controller that stopped last
+  ros::Time                    stopped;
+};
+
+/**
+ * @brief Process-wide handovers between controllers of the same joints
+ *
+ * When switching e.g. from a motion to a force controller, the new one
+ * continues the simulated joint velocities of the old one instead of
+ * starting from the measured ones.  Controllers with the same joints share
+ * one handover.
+ *
+ * All functions are thread-safe, but not realtime safe.
+ */
+class SolverRegistry
+{
+  public:
+    /**
+     * @brief Get the handover for a set of joints
+     *
+     * The first call creates the handover.
+     *
+     * @param joints The names of the controlled joints, in the controller's order
+     *
+     * @return The shared handover
+     */
+    static std::shared_ptr<SolverHandover> get(const std::vector<std::string>& joints);
+
+  private:
+    static std::mutex                                               m_mutex;
+    static std::map<std::vector<std::string>, std::shared_ptr<SolverHandover> > m_handovers;
+};
+
+}
+
+#endif
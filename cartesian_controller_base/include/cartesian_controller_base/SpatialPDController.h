@@ -43,10 +43,20 @@
 // Project
 #include <cartesian_controller_base/Utility.h>
 #include <cartesian_controller_base/PDController.h>
+#include <cartesian_controller_base/TripleBuffer.h>
 
 // ROS
 #include <ros/ros.h>
 
+// Dynamic reconfigure
+#include <dynamic_reconfigure/server.h>
+#include <cartesian_controller_base/PDGainsConfig.h>
+
+// Other
+#include <memory>
+#include <mutex>
+#include <vector>
+
 namespace cartesian_controller_base
 {
 
@@ -55,6 +65,13 @@ namespace cartesian_controller_base
  *
  * This class implements separate PD controllers for each of the Cartesian
  * axes, i.e. three translational controllers and three rotational controllers.
+ *
+ * By default, all six axes are computed at once on vectors, with one read of
+ * all gains per call.  The gains are still tuned per axis with dynamic
+ * reconfigure.  The vectorized version optionally low-pass filters the
+ * derivative of the error with the time constant in
+ * \a pd_gains/derivative_filter (seconds).  Set \a pd_gains/vectorized to false
+ * to use six \ref PDController instances instead.
  */
 class SpatialPDController
 {
@@ -77,6 +94,26 @@ class SpatialPDController
     ctrl::Vector6D m_cmd;
     std::vector<PDController> m_pd_controllers;
 
+    // Vectorized
+    struct Gains
+    {
+      ctrl::Vector6D p = ctrl::Vector6D::Zero(); ///< proportional gains
+      ctrl::Vector6D d = ctrl::Vector6D::Zero(); ///< derivative gains
+    };
+
+    typedef cartesian_controller_base::PDGainsConfig PDGainsConfig;
+    void dynamicReconfigureCallback(PDGainsConfig& config, uint32_t level, int axis);
+
+    bool                m_vectorized;
+    double              m_derivative_filter;  ///< time constant in seconds
+    ctrl::Vector6D      m_last_error;
+    ctrl::Vector6D      m_error_derivative;
+    TripleBuffer<Gains> m_gains;
+    Gains               m_gains_nonrt;        ///< Guarded by m_gains_mutex
+    std::mutex          m_gains_mutex;
+
+    std::vector<std::shared_ptr<dynamic_reconfigure::Server<PDGainsConfig> > > m_dyn_conf_servers;
+
 };
 
 } // namespace
@@ -0,0 +1,206 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    StageTimer.h
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef STAGE_TIMER_H_INCLUDED
+#define STAGE_TIMER_H_INCLUDED
+
+// Other
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+namespace cartesian_controller_base
+{
+
+/**
+ * @brief Execution time statistics of a single stage
+ *
+ * Durations are sorted into a histogram with four bins per power of two,
+ * which bounds the error of percentiles to 25 %.  Recording is constant time
+ * and doesn't allocate.
+ */
+class StageStatistics
+{
+  public:
+    StageStatistics()
+    {
+      reset();
+    }
+
+    void reset()
+    {
+      m_count = 0;
+      m_sum = 0;
+      m_min = std::numeric_limits<std::uint64_t>::max();
+      m_max = 0;
+      m_histogram.fill(0);
+    }
+
+    /**
+     * @brief Add a duration
+     *
+     * @param nanoseconds The stage's execution time
+     */
+    void record(std::uint64_t nanoseconds)
+    {
+      ++m_count;
+      m_sum += nanoseconds;
+      m_min = std::min(m_min, nanoseconds);
+      m_max = std::max(m_max, nanoseconds);
+      ++m_histogram[bin(nanoseconds)];
+    }
+
+    std::uint64_t count() const { return m_count; }
+
+    //! Minimum in seconds
+    double min() const { return m_count ? m_min * 1e-9 : 0.0; }
+
+    //! Mean in seconds
+    double mean() const { return m_count ? m_sum * 1e-9 / m_count : 0.0; }
+
+    //! Maximum in seconds
+    double max() const { return m_max * 1e-9; }
+
+    /**
+     * @brief Estimate a percentile from the histogram
+     *
+     * @param fraction The percentile in [0, 1], e.g. 0.99
+     *
+     * @return The upper edge of the according bin in seconds, limited by the maximum
+     */
+    double percentile(double fraction) const
+    {
+      if (m_count == 0)
+      {
+        return 0.0;
+      }
+      const std::uint64_t rank = static_cast<std::uint64_t>(fraction * (m_count - 1)) + 1;
+      std::uint64_t sum = 0;
+      for (int i = 0; i < BINS; ++i)
+      {
+        sum += m_histogram[i];
+        if (sum >= rank)
+        {
+          return std::min(upperEdge(i), m_max) * 1e-9;
+        }
+      }
+      return max();
+    }
+
+  private:
+    static constexpr int BINS = 160;  ///< Covers up to 2^41 ns
+
+    //! Four bins per octave, exact for values below 4
+    static int bin(std::uint64_t value)
+    {
+      if (value < 4)
+      {
+        return static_cast<int>(value);
+      }
+      const int octave = 63 - __builtin_clzll(value);
+      const int sub = static_cast<int>(value >> (octave - 2)) & 0x3;
+      return std::min((octave - 1) * 4 + sub, BINS - 1);
+    }
+
+    static std::uint64_t upperEdge(int bin)
+    {
+      if (bin < 4)
+      {
+        return bin + 1;
+      }
+      const int octave = bin / 4 + 1;
+      const int sub = bin % 4;
+      return static_cast<std::uint64_t>(5 + sub) << (octave - 2);
+    }
+
+    std::uint64_t m_count;
+    std::uint64_t m_sum;
+    std::uint64_t m_min;
+    std::uint64_t m_max;
+    std::array<std::uint32_t, BINS> m_histogram;
+};
+
+/**
+ * @brief Lightweight timer for consecutive stages of a realtime loop
+ *
+ * Call start() at the beginning of a cycle and lap() at the end of each
+ * stage.  Each lap measures the time since the last call of either function
+ * with a monotonic clock.
+ *
+ * @tparam Stages The number of stages
+ */
+template <int Stages>
+class StageTimer
+{
+  public:
+    void start()
+    {
+      m_last = std::chrono::steady_clock::now();
+    }
+
+    void lap(int stage)
+    {
+      const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+      m_stages[stage].record(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_last).count());
+      m_last = now;
+    }
+
+    const StageStatistics& operator[](int stage) const
+    {
+      return m_stages[stage];
+    }
+
+    void reset()
+    {
+      for (auto& stage : m_stages)
+      {
+        stage.reset();
+      }
+    }
+
+  private:
+    std::array<StageStatistics, Stages> m_stages;
+    std::chrono::steady_clock::time_point m_last;
+};
+
+}
+
+#endif
@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    StateStream.h
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef STATE_STREAM_H_INCLUDED
+#define STATE_STREAM_H_INCLUDED
+
+// Other
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace cartesian_controller_base
+{
+
+/**
+ * @brief A compact stream of end effector states in shared memory
+ *
+ * This is for local loggers and monitors that need every control cycle,
+ * without going through ROS topics.  The controller writes one fixed-size
+ * \ref Record per cycle into a ring in POSIX shared memory.  Writing neither
+ * allocates nor locks, and it never waits for readers.  Readers that fall
+ * behind by more than the ring's capacity lose records.
+ *
+ * Layout of the shared memory: one \ref Header, followed by \a capacity
+ * records.  Record \a n (counting from zero) is in slot \a n % \a capacity.
+ * Each record's \a sequence is odd while the writer updates it and
+ * 2 * (n + 1) once record \a n is complete.  Readers copy a record and
+ * accept the copy only if \a sequence was the same, even value before and
+ * after copying.
+ */
+class StateStream
+{
+  public:
+    static constexpr uint32_t MAGIC = 0x43435353;  // "CCSS"
+    static constexpr uint32_t VERSION = 1;
+
+    struct Header
+    {
+      uint32_t magic;
+      uint32_t version;
+      uint32_t capacity;      ///< Number of records in the ring
+      uint32_t record_size;   ///< In bytes
+      std::atomic<uint64_t> written;  ///< Number of completed records
+    };
+
+    struct Record
+    {
+      std::atomic<uint64_t> sequence;
+      int64_t stamp;          ///< Nanoseconds of ros::Time
+      double  position[3];    ///< End effector position in the robot base link
+      double  rotation[9];    ///< End effector orientation, row major
+      double  twist[6];       ///< Linear, then angular velocity
+      double  wrench[6];      ///< Force, then torque
+    };
+
+    StateStream();
+    ~StateStream();
+
+    StateStream(const StateStream&) = delete;
+    StateStream& operator=(const StateStream&) = delete;
+
+    /**
+     * @brief Create the shared memory
+     *
+     * Call this once outside the realtime loop.
+     *
+     * @param name The name of the shared memory object, e.g. /my_controller
+     * @param capacity The number of records in the ring
+     *
+     * @return True, if the shared memory could be created and mapped
+     */
+    bool init(const std::string& name, size_t capacity);
+
+    /**
+     * @brief Whether \ref init succeeded
+     */
+    bool isOpen() const { return m_header != nullptr; }
+
+    /**
+     * @brief Get the next record to fill in
+     *
+     * Realtime safe.  Fill in the record's data and call \ref commit.  The
+     * stream must be open.
+     *
+     * @return The record
+     */
+    Record& beginWrite();
+
+    /**
+     * @brief Publish the record from \ref beginWrite to readers
+     */
+    void commit();
+
+  private:
+    std::string m_name;
+    size_t      m_size;
+    Header*     m_header;
+    Record*     m_records;
+    uint64_t    m_written;
+};
+
+}
+
+#endif
@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    TargetRegistry.h
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef TARGET_REGISTRY_H_INCLUDED
+#define TARGET_REGISTRY_H_INCLUDED
+
+// Project
+#include <cartesian_controller_base/TripleBuffer.h>
+
+// KDL
+#include <kdl/frames.hpp>
+
+// Other
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace cartesian_controller_base
+{
+
+//! Target poses from one controller to another one in the same process
+typedef TripleBuffer<KDL::Frame> TargetChannel;
+
+/**
+ * @brief Process-wide channels for target poses between co-located controllers
+ *
+ * Controllers that produce target poses, such as the
+ * joint_to_cartesian_controller, can hand them directly to Cartesian
+ * controllers in the same process instead of publishing them on a topic.
+ * Both sides get the same channel by the fully resolved name of the target
+ * topic.  Each channel takes one writer and one reader at a time.  The
+ * handles that the registry returns keep that place until they are released.
+ *
+ * All functions are thread-safe, but not realtime safe.  Reading and
+ * writing the channels is.
+ */
+class TargetRegistry
+{
+  public:
+    /**
+     * @brief Read the targets of a topic
+     *
+     * The first call for a topic creates the channel.
+     *
+     * @param topic The fully resolved name of the target topic
+     * @param frame_id The reference frame of the target poses
+     *
+     * @return The reader's handle of the channel, or nullptr if the channel
+     * already has a reader or is in use with a different reference frame
+     */
+    static std::shared_ptr<TargetChannel> getReader(const std::string& topic, const std::string& frame_id);
+
+    /**
+     * @brief Write the targets of a topic
+     *
+     * @see getReader
+     *
+     * @return The writer's handle of the channel, or nullptr if the channel
+     * already has a writer or is in use with a different reference frame
+     */
+    static std::shared_ptr<TargetChannel> getWriter(const std::string& topic, const std::string& frame_id);
+
+  private:
+    struct Entry
+    {
+      std::string frame_id;
+      std::shared_ptr<TargetChannel> channel;
+      std::weak_ptr<TargetChannel>   reader;
+      std::weak_ptr<TargetChannel>   writer;
+    };
+
+    static std::shared_ptr<TargetChannel> get(const std::string& topic,
+                                              const std::string& frame_id,
+                                              bool reader);
+
+    static std::mutex                    m_mutex;
+    static std::map<std::string, Entry>  m_channels;
+};
+
+}
+
+#endif
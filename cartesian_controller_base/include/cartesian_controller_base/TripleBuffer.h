@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    TripleBuffer.h
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef TRIPLE_BUFFER_H_INCLUDED
+#define TRIPLE_BUFFER_H_INCLUDED
+
+// Other
+#include <atomic>
+#include <cstdint>
+
+namespace cartesian_controller_base
+{
+
+/**
+ * @brief A lock-free buffer to hand data from one non-realtime to one realtime thread
+ *
+ * This is a drop-in alternative to realtime_tools::RealtimeBuffer for a
+ * single writer and a single reader.  The writer and the reader each own one
+ * of three slots.  The third slot is exchanged atomically between them, so
+ * neither side ever waits for the other, and the reader always sees a
+ * complete value.  Values that the reader has not picked up in time are
+ * silently replaced by newer ones.
+ *
+ * Neither reading nor writing allocates, given that copying \a T doesn't.
+ *
+ * @tparam T The data to hand over. Must be copy-assignable.
+ */
+template <class T>
+class TripleBuffer
+{
+  public:
+    TripleBuffer()
+      : m_write_index(0), m_shared_index(1), m_read_index(2)
+    {
+    }
+
+    explicit TripleBuffer(const T& data)
+      : TripleBuffer()
+    {
+      for (auto& slot : m_slots)
+      {
+        slot.data = data;
+      }
+    }
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * @brief Publish new data from the non-realtime side
+     *
+     * Call this from one thread only.
+     *
+     * @param data The data to publish
+     */
+    void writeFromNonRT(const T& data)
+    {
+      m_slots[m_write_index].data = data;
+      m_write_index =
+        m_shared_index.exchange(m_write_index | NEW_DATA, std::memory_order_acq_rel) & INDEX;
+    }
+
+    /**
+     * @brief Get the most recent data on the realtime side
+     *
+     * Call this from one thread only.  This is wait-free.
+     *
+     * @return A pointer to the latest data. It stays valid until the next call
+     * to readFromRT() or initRT().
+     */
+    T* readFromRT()
+    {
+      if (hasNewData())
+      {
+        m_read_index =
+          m_shared_index.exchange(m_read_index, std::memory_order_acq_rel) & INDEX;
+      }
+      return &m_slots[m_read_index].data;
+    }
+
+    /**
+     * @brief Overwrite the data from the realtime side
+     *
+     * Data that the writer has published but the reader has not picked up yet
+     * are discarded.  Use this e.g. to reset targets on controller start.
+     *
+     * @param data The new data
+     */
+    void initRT(const T& data)
+    {
+      readFromRT();
+      m_slots[m_read_index].data = data;
+    }
+
+    /**
+     * @brief Check for data that the reader has not picked up yet
+     *
+     * @return True if there are new data since the last readFromRT()
+     */
+    bool hasNewData() const
+    {
+      return m_shared_index.load(std::memory_order_relaxed) & NEW_DATA;
+    }
+
+  private:
+    static constexpr std::uint8_t INDEX = 0x3;
+    static constexpr std::uint8_t NEW_DATA = 0x4;
+
+    //! Separate cache lines against false sharing between writer and reader
+    struct alignas(64) Slot
+    {
+      T data;
+    };
+
+    Slot m_slots[3];
+
+    alignas(64) std::uint8_t  m_write_index;  ///< Owned by the writer
+    alignas(64) std::atomic<std::uint8_t> m_shared_index;
+    alignas(64) std::uint8_t  m_read_index;   ///< Owned by the reader
+};
+
+}
+
+#endif
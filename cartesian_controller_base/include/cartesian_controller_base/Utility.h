@@ -62,6 +62,25 @@
 
     typedef Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic> MatrixND;
 
+    /*! \brief Joint space typedefs with the number of joints as template parameter
+     *
+     *  Use Eigen::Dynamic if the number of joints is unknown at compile time.
+     */
+    template <int Joints>
+    using VectorN = Eigen::Matrix<double,Joints,1>;
+
+    template <int Joints>
+    using MatrixN = Eigen::Matrix<double,Joints,Joints>;
+
+    template <int Joints>
+    using Matrix6N = Eigen::Matrix<double,6,Joints>;
+
+    /*! \brief View on the row-major data of a KDL::Rotation
+     *
+     *  Use this to compute with KDL rotations without copying them.
+     */
+    typedef Eigen::Map<const Eigen::Matrix<double,3,3,Eigen::RowMajor> > RotationMap;
+
   }
 
 #endif
@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    WorkerPool.h
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef WORKER_POOL_H_INCLUDED
+#define WORKER_POOL_H_INCLUDED
+
+// Other
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <semaphore.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cartesian_controller_base
+{
+
+/**
+ * @brief Pin a thread to a CPU core and give it a realtime priority
+ *
+ * @param thread The thread to configure
+ * @param name The thread's name for error messages
+ * @param cpu The CPU core to pin to. Negative values keep the thread unpinned.
+ * @param priority The SCHED_FIFO priority. Zero keeps the default scheduling.
+ *
+ * @return True, if the thread could be configured as requested
+ */
+bool configureWorkerThread(std::thread& thread, const std::string& name, int cpu, int priority);
+
+/**
+ * @brief A fixed set of tasks that run in parallel once per control cycle
+ *
+ * Each task gets its own worker thread, which is created once in \ref init.
+ * The realtime thread starts all tasks with \ref run, executes the first task
+ * itself and returns once every task is done.  This acts as a barrier within
+ * the control cycle.  Calling \ref run neither allocates nor locks.
+ *
+ * Workers can be pinned to CPU cores and be given a realtime priority, so
+ * that they don't compete with the rest of the system.
+ */
+class WorkerPool
+{
+  public:
+    WorkerPool();
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * @brief Start the worker threads
+     *
+     * Call this once outside the realtime loop.
+     *
+     * @param tasks The tasks to run in each cycle. The first one runs in the
+     * thread that calls \ref run.
+     * @param cpus Optional CPU core for each worker, in the order of the
+     * remaining tasks. Workers without a core are not pinned.
+     * @param priority Optional SCHED_FIFO priority for the workers. Zero
+     * keeps the default scheduling.
+     *
+     * @return True, if all workers could be started as requested
+     */
+    bool init(const std::vector<std::function<void()> >& tasks,
+              const std::vector<int>& cpus = std::vector<int>(),
+              int priority = 0);
+
+    /**
+     * @brief Run all tasks once and wait for them to finish
+     *
+     * Realtime safe.
+     */
+    void run();
+
+  private:
+    void work(int task);
+    void stop();
+
+    std::vector<std::function<void()> > m_tasks;
+    std::vector<std::thread>            m_workers;
+    std::unique_ptr<sem_t[]>            m_start;
+    std::atomic<int>                    m_pending;
+    std::atomic<bool>                   m_running;
+};
+
+}
+
+#endif
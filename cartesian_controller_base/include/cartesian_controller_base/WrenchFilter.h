@@ -0,0 +1,186 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    WrenchFilter.h
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef WRENCH_FILTER_H_INCLUDED
+#define WRENCH_FILTER_H_INCLUDED
+
+// Project
+#include <cartesian_controller_base/Utility.h>
+
+// Other
+#include <cmath>
+
+namespace cartesian_controller_base
+{
+
+/**
+ * @brief A second order filter for all six axes of a wrench
+ *
+ * This is a biquad in transposed direct form II.  Feed it one sample at a
+ * time at the rate that the coefficients were designed for.  Filtering
+ * neither allocates nor locks.
+ */
+class WrenchFilter
+{
+  public:
+    /**
+     * @brief Normalized filter coefficients
+     *
+     * Designed after Robert Bristow-Johnson's Audio EQ Cookbook.  All
+     * designs have unit gain at zero frequency.
+     */
+    struct Coefficients
+    {
+      double b0 = 1.0;
+      double b1 = 0.0;
+      double b2 = 0.0;
+      double a1 = 0.0;
+      double a2 = 0.0;
+
+      //! Pass samples through unchanged
+      static Coefficients passThrough()
+      {
+        return Coefficients();
+      }
+
+      /**
+       * @brief Attenuate frequencies above a cutoff frequency
+       *
+       * @param frequency The cutoff frequency in Hz, below half the sample rate
+       * @param sample_rate The rate of the samples in Hz
+       * @param q The quality factor. 0.7071 gives a Butterworth filter.
+       */
+      static Coefficients lowPass(double frequency, double sample_rate, double q)
+      {
+        const double w0 = 2.0 * M_PI * frequency / sample_rate;
+        const double cos_w0 = std::cos(w0);
+        const double alpha = std::sin(w0) / (2.0 * q);
+        return normalize(
+            (1.0 - cos_w0) / 2.0, 1.0 - cos_w0, (1.0 - cos_w0) / 2.0,
+            1.0 + alpha, -2.0 * cos_w0, 1.0 - alpha);
+      }
+
+      /**
+       * @brief Reject a narrow band around a center frequency
+       *
+       * Use this e.g. against vibrations of the robot or the tool.
+       *
+       * @param frequency The center frequency in Hz, below half the sample rate
+       * @param sample_rate The rate of the samples in Hz
+       * @param q The quality factor. Higher values give a narrower band.
+       */
+      static Coefficients notch(double frequency, double sample_rate, double q)
+      {
+        const double w0 = 2.0 * M_PI * frequency / sample_rate;
+        const double cos_w0 = std::cos(w0);
+        const double alpha = std::sin(w0) / (2.0 * q);
+        return normalize(
+            1.0, -2.0 * cos_w0, 1.0,
+            1.0 + alpha, -2.0 * cos_w0, 1.0 - alpha);
+      }
+
+      private:
+      static Coefficients normalize(double b0, double b1, double b2, double a0, double a1, double a2)
+      {
+        Coefficients c;
+        c.b0 = b0 / a0;
+        c.b1 = b1 / a0;
+        c.b2 = b2 / a0;
+        c.a1 = a1 / a0;
+        c.a2 = a2 / a0;
+        return c;
+      }
+    };
+
+    WrenchFilter()
+    {
+      reset(ctrl::Vector6D::Zero());
+    }
+
+    /**
+     * @brief Use new coefficients
+     *
+     * The filter continues in steady state at its last output, so that
+     * switching coefficients while filtering doesn't cause a transient.
+     */
+    void setCoefficients(const Coefficients& coefficients)
+    {
+      m_c = coefficients;
+      reset(m_output);
+    }
+
+    /**
+     * @brief Start in steady state
+     *
+     * @param wrench The input that the filter has seemingly seen forever
+     */
+    void reset(const ctrl::Vector6D& wrench)
+    {
+      m_z2 = (m_c.b2 - m_c.a2) * wrench;
+      m_z1 = (m_c.b1 - m_c.a1) * wrench + m_z2;
+      m_output = wrench;
+    }
+
+    /**
+     * @brief Filter the next sample
+     *
+     * @param wrench The new input sample
+     *
+     * @return The filtered wrench
+     */
+    const ctrl::Vector6D& filter(const ctrl::Vector6D& wrench)
+    {
+      m_output = m_c.b0 * wrench + m_z1;
+      m_z1 = m_c.b1 * wrench - m_c.a1 * m_output + m_z2;
+      m_z2 = m_c.b2 * wrench - m_c.a2 * m_output;
+      return m_output;
+    }
+
+    //! The last filtered wrench
+    const ctrl::Vector6D& output() const { return m_output; }
+
+  private:
+    Coefficients    m_c;
+    ctrl::Vector6D  m_z1;
+    ctrl::Vector6D  m_z2;
+    ctrl::Vector6D  m_output;
+};
+
+}
+
+#endif
@@ -47,17 +47,28 @@
 #include <geometry_msgs/PoseStamped.h>
 #include <geometry_msgs/TwistStamped.h>
 #include <realtime_tools/realtime_publisher.h>
+#include <cartesian_controller_base/IterationStatistics.h>
+#include <cartesian_controller_base/StageTimings.h>
+#include <cartesian_controller_base/CartesianState.h>
 
 // ros_controls
 #include <controller_interface/controller.h>
 #include <hardware_interface/joint_command_interface.h>
+#include <hardware_interface/robot_hw.h>
 
 // KDL
-#include <kdl/treefksolverpos_recursive.hpp>
+#include <kdl/jntarrayvel.hpp>
 
 // Project
+#include <cartesian_controller_base/AllocationTracker.h>
+#include <cartesian_controller_base/AsyncWorker.h>
 #include <cartesian_controller_base/IKSolver.h>
+#include <cartesian_controller_base/JointPreviewInterface.h>
+#include <cartesian_controller_base/RobotModelRegistry.h>
+#include <cartesian_controller_base/SolverRegistry.h>
 #include <cartesian_controller_base/SpatialPDController.h>
+#include <cartesian_controller_base/StageTimer.h>
+#include <cartesian_controller_base/StateStream.h>
 #include <cartesian_controller_base/Utility.h>
 
 // Dynamic reconfigure
@@ -70,6 +81,9 @@
 // Other
 #include <vector>
 #include <string>
+#include <chrono>
+#include <functional>
+#include <memory>
 
 namespace cartesian_controller_base
 {
@@ -90,21 +104,248 @@ class CartesianControllerBase : public controller_interface::Controller<Hardware
 {
   public:
     CartesianControllerBase();
-    virtual ~CartesianControllerBase<HardwareInterface>(){};
+    virtual ~CartesianControllerBase<HardwareInterface>();
+
+    /**
+     * @brief Get optional joint preview handles before initialization
+     *
+     * If the parameter \a preview_horizon is set, the controller writes that
+     * many predicted commands per joint into the robot hardware's
+     * JointPreviewInterface after each solver cycle.
+     *
+     * The preview costs up to \a preview_horizon times \a solver/iterations
+     * extra IK solver steps per solver cycle.  init() shortens the horizon
+     * to stay within \a preview_max_solver_steps, by default 100.
+     */
+    virtual bool initRequest(hardware_interface::RobotHW* robot_hw,
+                             ros::NodeHandle& root_nh,
+                             ros::NodeHandle& controller_nh,
+                             controller_interface::ControllerBase::ClaimedResources& claimed_resources);
 
     virtual bool init(HardwareInterface* hw, ros::NodeHandle& nh);
 
+    /**
+     * @brief Start from the real robot's joint state
+     *
+     * If another controller of the same joints stopped in this control
+     * cycle, e.g. on a controller switch, this continues its simulated joint
+     * velocities.
+     */
     virtual void starting(const ros::Time& time);
 
+    /**
+     * @brief Hand the simulated motion over to the next controller
+     *
+     * Derived controllers must call this in their stopping().
+     */
+    virtual void stopping(const ros::Time& time);
+
+    /**
+     * @brief Use an existing plugin loader for the IK solver
+     *
+     * Call this before \ref init to share the loader between controllers
+     * that drive several chains of the same robot.
+     *
+     * @param solver_loader The plugin loader to create the IK solver with
+     */
+    void setSolverLoader(std::shared_ptr<pluginlib::ClassLoader<IKSolver> > solver_loader);
+
   protected:
+    /**
+     * @brief Stages of the realtime loop for execution time measurements
+     */
+    enum Stage
+    {
+      SYNCHRONIZATION,
+      ERROR_COMPUTATION,
+      PD_CONTROL,
+      IK_SOLVER,
+      KINEMATICS,
+      WRITE_COMMANDS,
+      NUMBER_OF_STAGES
+    };
+
+    /**
+     * @brief Start measuring the stages of this control cycle
+     *
+     * Call this at the beginning of update().  Measurements are only taken
+     * if enabled with dynamic reconfigure.
+     */
+    void startStageTimer();
+
+    /**
+     * @brief Finish the measurement of a stage
+     *
+     * @param stage The stage that took place since the last call of this
+     * function or \ref startStageTimer
+     */
+    void lapStageTimer(Stage stage);
+
+    /**
+     * @brief Keep the stage timings for the owner instead of publishing them
+     *
+     * For offline tools that run the controller outside of a control
+     * manager.  While collecting, every cycle is measured and the
+     * statistics accumulate until \ref resetStageStatistics.
+     *
+     * @param collect Whether to collect the timings
+     */
+    void collectStageTimings(bool collect) { m_collect_stage_timings = collect; }
+
+    /**
+     * @brief Execution times of a stage since the last reset
+     *
+     * @param stage One of \ref Stage. \a NUMBER_OF_STAGES gives the null
+     * space timings, which are nested within the IK solver's stage.
+     */
+    const StageStatistics& getStageStatistics(int stage) const
+    {
+      return stage < NUMBER_OF_STAGES ? m_stage_timer[stage] : m_null_space_timings;
+    }
+
+    void resetStageStatistics()
+    {
+      m_stage_timer.reset();
+      m_null_space_timings.reset();
+    }
+
+    //! Solver iterations of the last control cycle
+    int getIterationsDone() const { return m_iterations_done; }
+
+    //! Error norm of the last solver iteration
+    double getLastErrorNorm() const { return m_last_error_norm; }
+
+    //! Whether the last cycle's iterations stopped below the error tolerance
+    bool hasConverged() const { return m_converged; }
+
+    /**
+     * @brief Count the heap allocations of this control cycle
+     *
+     * Keep the returned scope alive for the whole update().  This only
+     * counts if enabled with the parameter *track_allocations* and if the
+     * executable links the allocation hooks, see \ref AllocationHooks.h.
+     * The counts are reported when the controller stops.
+     *
+     * Trackers only see the allocations of their own thread.  The
+     * asynchronous solver therefore counts for \ref getAsyncAllocationTracker.
+     * Owners that run \ref computeJointMotion on other threads, e.g. on a
+     * WorkerPool, keep a scope alive there, too.
+     */
+    AllocationTracker::Scope trackAllocations()
+    {
+      return AllocationTracker::Scope(m_allocation_tracker.get());
+    }
+
+    //! Nullptr, if allocations are not tracked
+    AllocationTracker* getAllocationTracker() { return m_allocation_tracker.get(); }
+
+    //! Of the asynchronous solver's thread. Nullptr, if not tracked or not asynchronous
+    AllocationTracker* getAsyncAllocationTracker() { return m_async_allocation_tracker.get(); }
+
+    /**
+     * @brief Forget the allocations so far, e.g. after warming up
+     *
+     * Waits for the asynchronous solver.  Not realtime safe.
+     */
+    void resetAllocationTrackers();
+
+    /**
+     * @brief Switch to one of the preloaded IK solvers
+     *
+     * The realtime loop switches on its next cycle.  Safe to call from other
+     * threads, e.g. from dynamic reconfigure.
+     *
+     * @param name One of the names in *ik_solvers*
+     *
+     * @return False, if no such solver is preloaded
+     */
+    bool selectIKSolver(const std::string& name);
+
+    /**
+     * @brief Synchronize the IK solver's joint positions with the real robot
+     *
+     * Call this at the beginning of update().  If another preloaded IK solver
+     * was selected with dynamic reconfigure, this also switches to that
+     * solver, which continues from the simulated state of the previous one.
+     * Realtime safe.
+     */
+    void synchronizeJointPositions();
+
     /**
      * @brief Write joint control commands to the real hardware
      *
      * Depending on the hardware interface used, this is either joint positions
-     * or velocities.
+     * or velocities.  After a solver cycle announced by
+     * \ref interpolateJointControlCmds, this writes the first interpolation
+     * step towards the new solution.  Otherwise, this writes the solution
+     * itself, e.g. when starting or stopping.
      */
     void writeJointControlCmds();
 
+    /**
+     * @brief Interpolate joint control commands between solver cycles
+     *
+     * Call this at the very beginning of update().  With
+     * *solver/solver_decimation* N > 1, the IK solver runs only in every
+     * N-th control cycle.  The commands of the cycles in between move
+     * linearly from the previous solution to the latest one, such that they
+     * reach it right before the next solver cycle.  Realtime safe.
+     *
+     * @return True if this cycle's commands are written and update() should
+     * return.  False if update() should compute a new solution as usual.
+     */
+    bool interpolateJointControlCmds();
+
+    /**
+     * @brief Set the controller's solver step for asynchronous execution
+     *
+     * The step covers everything of update() that comes before writing the
+     * commands, i.e. synchronization, error computation and the IK solver.
+     * Set this in init().  Derived controllers replace the step of their
+     * parents.
+     *
+     * @param task The solver step. Gets the time of the control cycle.
+     */
+    void setSolverTask(const std::function<void(const ros::Time&)>& task);
+
+    /**
+     * @brief Set how to copy the solver step's inputs from the realtime side
+     *
+     * The solver step must not read what the realtime thread keeps updating,
+     * e.g. hardware handles or filters.  This copy runs on the realtime
+     * thread right before each solver step, see \ref solveAsynchronously.
+     * Set this in init().
+     *
+     * @param snapshot Copies the inputs into members of the controller
+     */
+    void setSolverSnapshot(const std::function<void()>& snapshot);
+
+    /**
+     * @brief Solve this cycle on the asynchronous worker
+     *
+     * Call this in update() after \ref interpolateJointControlCmds.  With the
+     * parameter *async_solver*, this writes the solution of the previous
+     * cycle and starts the solver step on the current joint state.  Either
+     * way, this takes the snapshot of \ref setSolverSnapshot for the step.  The
+     * commands thereby lag one control cycle behind.  If the previous step is
+     * still busy, this holds position instead and discards the late
+     * solution.  Realtime safe.
+     *
+     * @param time The time of the current control cycle
+     *
+     * @return True if this cycle is handled and update() should return. False
+     * if update() should solve and write commands itself.
+     */
+    bool solveAsynchronously(const ros::Time& time);
+
+    /**
+     * @brief Wait for a running asynchronous solver step to finish
+     *
+     * Call this before using the IK solver outside of update(), e.g. in
+     * stopping().
+     */
+    void waitForSolver();
+
     /**
      * @brief Compute one control step using forward dynamics simulation
      *
@@ -115,6 +356,36 @@ class CartesianControllerBase : public controller_interface::Controller<Hardware
      */
     void computeJointControlCmds(const ctrl::Vector6D& error, const ros::Duration& period);
 
+    /**
+     * @brief Start a new sequence of solver iterations in this control cycle
+     *
+     * Call this before iterating with \ref continueIterations.
+     */
+    void beginIterations();
+
+    /**
+     * @brief Decide whether to run another solver iteration
+     *
+     * Call this with each new error, right before \ref computeJointControlCmds.
+     * By default, this always returns true and it's up to the caller to run
+     * \ref m_iterations iterations.  In adaptive mode, this returns false as
+     * soon as the error norm falls below the tolerance, or if another
+     * iteration would exceed the time budget.  The first iteration of a
+     * cycle always runs.
+     *
+     * @param error The error to minimize in the next iteration
+     *
+     * @return True if the next iteration should run
+     */
+    bool continueIterations(const ctrl::Vector6D& error);
+
+    /**
+     * @brief Finish the solver iterations of this control cycle
+     *
+     * Publishes iteration statistics if state feedback is enabled.
+     */
+    void endIterations();
+
     /**
      * @brief Display the given vector in the given robot base link
      *
@@ -147,6 +418,60 @@ class CartesianControllerBase : public controller_interface::Controller<Hardware
      */
     ctrl::Vector6D displayInTipLink(const ctrl::Vector6D& vector, const std::string& to);
 
+    /**
+     * @brief Display the given vector in the given robot base link
+     *
+     * This is the fast version of the above for realtime loops.  It reuses the
+     * link frames of the current joint state.
+     *
+     * @param vector The quantity to transform
+     * @param from The link index of the reference frame where the quantity was
+     * formulated. Get this once with \ref getLinkIndex.
+     *
+     * @return The quantity in the robot base frame
+     */
+    ctrl::Vector6D displayInBaseLink(const ctrl::Vector6D& vector, int from);
+
+    /**
+     * @brief Display the given tensor in the robot base frame
+     *
+     * @param tensor The quantity to transform
+     * @param from The link index of the reference frame where the quantity was
+     * formulated. Get this once with \ref getLinkIndex.
+     *
+     * @return The quantity in the robot base frame
+     */
+    ctrl::Matrix6D displayInBaseLink(const ctrl::Matrix6D& tensor, int from);
+
+    /**
+     * @brief Display a given vector in a new reference frame
+     *
+     * The vector is assumed to be given in the robot base frame.
+     *
+     * @param vector The quantity to transform
+     * @param to The link index of the reference frame in which to formulate
+     * the quantity. Get this once with \ref getLinkIndex.
+     *
+     * @return The quantity in the new frame
+     */
+    ctrl::Vector6D displayInTipLink(const ctrl::Vector6D& vector, int to);
+
+    /**
+     * @brief Resolve a link name into an index for the functions above
+     *
+     * Call this once on initialization, since it involves string comparisons.
+     * Requires initialized IK solvers.
+     *
+     * @param link The link's name
+     *
+     * @return The link's index in the robot chain. Links that are not part of
+     * the chain, such as the robot base link, are treated as the base.
+     */
+    int getLinkIndex(const std::string& link)
+    {
+      return m_ik_solver->getSegmentIndex(link);
+    }
+
     /**
      * @brief Check if specified links are part of the robot chain
      *
@@ -167,17 +492,20 @@ class CartesianControllerBase : public controller_interface::Controller<Hardware
     }
 
     KDL::Chain m_robot_chain;
-
-    std::shared_ptr<KDL::TreeFkSolverPos_recursive> m_forward_kinematics_solver;
+    std::shared_ptr<const RobotModel> m_robot_model;
 
     /**
      * @brief Allow users to choose the IK solver type on startup
+     *
+     * All solvers in \a ik_solvers are loaded on initialization and can be
+     * switched at runtime.  \ref m_ik_solver is the active one.
      */
     std::shared_ptr<pluginlib::ClassLoader<IKSolver> > m_solver_loader;
     std::shared_ptr<IKSolver> m_ik_solver;
 
     std::string m_end_effector_link;
     std::string m_robot_base_link;
+    int         m_end_effector_link_index;
 
     int m_iterations;
     std::vector<hardware_interface::JointHandle>      m_joint_handles;
@@ -188,6 +516,12 @@ class CartesianControllerBase : public controller_interface::Controller<Hardware
      */
     std::atomic<bool> m_publish_state_feedback = false;
 
+    /**
+     * The measured wrench for state feedback, w.r.t. the robot base link.
+     * Controllers with force sensing should update this in each cycle.
+     */
+    ctrl::Vector6D m_feedback_wrench = ctrl::Vector6D::Zero();
+
     /**
      * @brief Publish the controller's end-effector pose and twist
      *
@@ -196,16 +530,80 @@ class CartesianControllerBase : public controller_interface::Controller<Hardware
      * been called, then the controller's internal state represents the state
      * right after the error computation, and corresponds to the new target
      * state that will be send to the actuators in this control cycle.
+     *
+     * Depending on the configuration, this publishes only every n-th call,
+     * publishes pose, twist and wrench in one message, and writes to the
+     * shared memory \ref StateStream in each call.
      */
     void publishStateFeedback();
 
   private:
+    /**
+     * @brief Write commands on the way from the previous to the latest solution
+     *
+     * @param progress Zero for the previous, one for the latest solution
+     */
+    void setJointCommands(double progress);
+
+    //! Stop where the robot is, or keep it there
+    void holdJointCommands();
+
+    /**
+     * @brief Predict the commands of the next control cycles
+     *
+     * Simulates the solver cycles of the next \ref m_preview_horizon control
+     * cycles with the last Cartesian input, without committing them.
+     */
+    void writeJointPreview();
+
     std::vector<std::string>                          m_joint_names;
-    trajectory_msgs::JointTrajectoryPoint             m_simulated_joint_motion;
+    KDL::JntArrayVel                                  m_simulated_joint_motion;
     SpatialPDController                              m_spatial_controller;
     ctrl::Vector6D                                    m_cartesian_input;
     double m_error_scale;
 
+    // Preloaded IK solvers
+    std::vector<std::string>                m_ik_solver_names;
+    std::vector<std::shared_ptr<IKSolver> > m_ik_solvers;
+    std::atomic<int>                        m_requested_ik_solver = 0;
+    int                                     m_active_ik_solver;
+
+    // Adaptive iterations
+    std::atomic<bool>   m_adaptive_iterations = false;
+    std::atomic<double> m_error_tolerance = 0.0;
+    std::atomic<double> m_time_budget = 0.0;  ///< seconds
+    std::chrono::steady_clock::time_point m_iterations_start;
+    std::chrono::steady_clock::time_point m_iteration_start;
+    int    m_iterations_done;
+    double m_last_error_norm;
+    bool   m_converged;
+
+    // Multi-rate control
+    std::atomic<int>  m_solver_decimation = 1;
+    KDL::JntArrayVel  m_interpolation_start;  ///< The previous solution
+    int               m_interpolation_step;
+    int               m_interpolation_steps;  ///< Of the current solution
+    bool              m_interpolate_next_write;
+
+    // Joint command preview
+    std::vector<JointPreviewHandle> m_preview_handles;
+    int                             m_preview_horizon;
+    KDL::JntArrayVel                m_preview_motion;
+    KDL::JntArrayVel                m_preview_start;  ///< Of the interpolation
+    ros::Duration                   m_last_period;  ///< Of the last solver step
+
+    // Continuous switching between controllers of the same joints
+    std::shared_ptr<SolverHandover> m_solver_handover;
+
+    // Asynchronous solver
+    std::function<void(const ros::Time&)> m_solver_task;
+    std::function<void()>                 m_solver_snapshot;
+    std::unique_ptr<AsyncWorker>          m_async_solver;
+    KDL::JntArray     m_async_positions;  ///< Snapshot of the real robot for the solver
+    ros::Time         m_async_time;
+    bool              m_async_solution_pending;
+    bool              m_async_solution_late;
+
     // Against multi initialization in multi inheritance scenarios
     bool m_already_initialized;
 
@@ -221,6 +619,32 @@ class CartesianControllerBase : public controller_interface::Controller<Hardware
       m_feedback_pose_publisher;
     realtime_tools::RealtimePublisherSharedPtr<geometry_msgs::TwistStamped>
       m_feedback_twist_publisher;
+    realtime_tools::RealtimePublisherSharedPtr<cartesian_controller_base::CartesianState>
+      m_feedback_state_publisher;
+
+    // State feedback decimation and streaming
+    std::atomic<int>  m_state_feedback_decimation = 1;
+    std::atomic<bool> m_combined_state_feedback = false;
+    int               m_state_feedback_cycle;
+    StateStream       m_state_stream;
+    realtime_tools::RealtimePublisherSharedPtr<cartesian_controller_base::IterationStatistics>
+      m_iteration_statistics_publisher;
+
+    // Execution time measurements
+    void publishStageTimings();
+
+    std::atomic<bool> m_publish_stage_timings = false;
+    bool m_collect_stage_timings = false;
+    bool m_stage_timer_running;
+    StageTimer<NUMBER_OF_STAGES> m_stage_timer;
+    StageStatistics m_null_space_timings;  ///< Nested within the IK solver's stage
+    std::chrono::steady_clock::time_point m_last_stage_timings;
+    realtime_tools::RealtimePublisherSharedPtr<cartesian_controller_base::StageTimings>
+      m_stage_timings_publisher;
+
+    // Heap allocations of the realtime thread and of the asynchronous solver
+    std::unique_ptr<AllocationTracker> m_allocation_tracker;
+    std::unique_ptr<AllocationTracker> m_async_allocation_tracker;
 
 };
 
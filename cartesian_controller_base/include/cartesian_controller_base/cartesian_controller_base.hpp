@@ -44,14 +44,10 @@
 #include <cartesian_controller_base/cartesian_controller_base.h>
 
 // KDL
-#include <cmath>
-#include <kdl/tree.hpp>
-#include <kdl_parser/kdl_parser.hpp>
 #include <kdl/jntarray.hpp>
 
-// URDF
-#include <urdf/model.h>
-#include <urdf_model/joint.h>
+// Other
+#include <algorithm>
 
 namespace cartesian_controller_base
 {
@@ -59,10 +55,74 @@ namespace cartesian_controller_base
 template <class HardwareInterface>
 CartesianControllerBase<HardwareInterface>::
 CartesianControllerBase()
-: m_already_initialized(false)
+: m_active_ik_solver(0), m_iterations_done(0), m_last_error_norm(0.0), m_converged(false),
+  m_interpolation_step(1), m_interpolation_steps(1), m_interpolate_next_write(false),
+  m_preview_horizon(0), m_async_solution_pending(false), m_async_solution_late(false),
+  m_already_initialized(false), m_state_feedback_cycle(0), m_stage_timer_running(false)
 {
 }
 
+template <class HardwareInterface>
+CartesianControllerBase<HardwareInterface>::
+~CartesianControllerBase()
+{
+  // Don't leave our solvers to the next controller on these joints
+  if (m_solver_handover)
+  {
+    for (const auto& solver : m_ik_solvers)
+    {
+      const IKSolver* expected = solver.get();
+      m_solver_handover->solver.compare_exchange_strong(expected, nullptr);
+    }
+  }
+}
+
+template <class HardwareInterface>
+bool CartesianControllerBase<HardwareInterface>::
+initRequest(hardware_interface::RobotHW* robot_hw,
+            ros::NodeHandle& root_nh,
+            ros::NodeHandle& controller_nh,
+            controller_interface::ControllerBase::ClaimedResources& claimed_resources)
+{
+  int preview_horizon = 0;
+  controller_nh.getParam("preview_horizon",preview_horizon);
+  if (preview_horizon > 0)
+  {
+    JointPreviewInterface* preview_interface = robot_hw->get<JointPreviewInterface>();
+    if (!preview_interface)
+    {
+      ROS_ERROR_STREAM(controller_nh.getNamespace() + "/preview_horizon" << " is set, "
+                       << "but the robot hardware has no JointPreviewInterface");
+      return false;
+    }
+    std::vector<std::string> joints;
+    controller_nh.getParam("joints",joints);  // Checked in init()
+    try
+    {
+      for (const auto& joint : joints)
+      {
+        m_preview_handles.push_back(preview_interface->getHandle(joint));
+        if (m_preview_handles.back().getHorizon() < static_cast<size_t>(preview_horizon))
+        {
+          ROS_ERROR_STREAM("The preview of joint " << joint << " holds only "
+                           << m_preview_handles.back().getHorizon() << " steps, "
+                           << "but preview_horizon is " << preview_horizon);
+          return false;
+        }
+      }
+    }
+    catch (const hardware_interface::HardwareInterfaceException& ex)
+    {
+      ROS_ERROR_STREAM(ex.what());
+      return false;
+    }
+    m_preview_horizon = preview_horizon;
+  }
+
+  return controller_interface::Controller<HardwareInterface>::initRequest(
+    robot_hw,root_nh,controller_nh,claimed_resources);
+}
+
 template <class HardwareInterface>
 bool CartesianControllerBase<HardwareInterface>::
 init(HardwareInterface* hw, ros::NodeHandle& nh)
@@ -72,37 +132,46 @@ init(HardwareInterface* hw, ros::NodeHandle& nh)
     return true;
   }
 
-  // Load user specified inverse kinematics solver
+  // Load user specified inverse kinematics solver.  Further solvers to
+  // switch to at runtime are loaded as well.
   std::string ik_solver = "forward_dynamics"; // Default
   nh.getParam("ik_solver", ik_solver);
+  nh.getParam("ik_solvers", m_ik_solver_names);
+  auto active = std::find(m_ik_solver_names.begin(), m_ik_solver_names.end(), ik_solver);
+  if (active == m_ik_solver_names.end())
+  {
+    active = m_ik_solver_names.insert(m_ik_solver_names.begin(), ik_solver);
+  }
+  m_active_ik_solver = active - m_ik_solver_names.begin();
+  m_requested_ik_solver = m_active_ik_solver;
 
-  m_solver_loader.reset(new pluginlib::ClassLoader<IKSolver>(
-    "cartesian_controller_base", "cartesian_controller_base::IKSolver"));
+  if (!m_solver_loader)  // Not shared with setSolverLoader()
+  {
+    m_solver_loader.reset(new pluginlib::ClassLoader<IKSolver>(
+      "cartesian_controller_base", "cartesian_controller_base::IKSolver"));
+  }
   try
   {
-    m_ik_solver = m_solver_loader->createUniqueInstance(ik_solver);
+    for (const auto& name : m_ik_solver_names)
+    {
+      m_ik_solvers.push_back(m_solver_loader->createUniqueInstance(name));
+    }
   }
   catch (pluginlib::PluginlibException& ex)
   {
     ROS_ERROR_STREAM(ex.what());
     return false;
   }
+  m_ik_solver = m_ik_solvers[m_active_ik_solver];
 
-  std::string robot_description;
-  urdf::Model robot_model;
-  KDL::Tree   robot_tree;
-
-  // Get controller specific configuration
-  if (!ros::param::search("robot_description", robot_description))
-  {
-    ROS_ERROR_STREAM("Searched enclosing namespaces for robot_description but nothing found");
-    return false;
-  }
-  if (!nh.getParam(robot_description, robot_description))
+  // Get controller specific configuration.  Controllers of the same robot
+  // share the parsed model.
+  m_robot_model = RobotModelRegistry::load(nh);
+  if (!m_robot_model)
   {
-    ROS_ERROR_STREAM("Failed to load " << robot_description << " from parameter server");
     return false;
   }
+
   if (!nh.getParam("robot_base_link",m_robot_base_link))
   {
     ROS_ERROR_STREAM("Failed to load " << nh.getNamespace() + "/robot_base_link" << " from parameter server");
@@ -115,19 +184,7 @@ init(HardwareInterface* hw, ros::NodeHandle& nh)
   }
 
   // Build a kinematic chain of the robot
-  if (!robot_model.initString(robot_description))
-  {
-    ROS_ERROR("Failed to parse urdf model from 'robot_description'");
-    return false;
-  }
-  if (!kdl_parser::treeFromUrdfModel(robot_model,robot_tree))
-  {
-    const std::string error = ""
-      "Failed to parse KDL tree from urdf model";
-    ROS_ERROR_STREAM(error);
-    throw std::runtime_error(error);
-  }
-  if (!robot_tree.getChain(m_robot_base_link,m_end_effector_link,m_robot_chain))
+  if (!m_robot_model->getChain(m_robot_base_link,m_end_effector_link,m_robot_chain))
   {
     const std::string error = ""
       "Failed to parse robot chain from urdf model. "
@@ -146,28 +203,14 @@ init(HardwareInterface* hw, ros::NodeHandle& nh)
   }
 
   // Parse joint limits
-  KDL::JntArray upper_pos_limits(m_joint_names.size());
-  KDL::JntArray lower_pos_limits(m_joint_names.size());
-  for (size_t i = 0; i < m_joint_names.size(); ++i)
+  KDL::JntArray upper_pos_limits;
+  KDL::JntArray lower_pos_limits;
+  if (!m_robot_model->getJointLimits(m_joint_names, upper_pos_limits, lower_pos_limits))
   {
-    if (!robot_model.getJoint(m_joint_names[i]))
-    {
-      const std::string error = ""
-        "Joint " + m_joint_names[i] + " does not appear in /robot_description";
-      ROS_ERROR_STREAM(error);
-      throw std::runtime_error(error);
-    }
-    if (robot_model.getJoint(m_joint_names[i])->type == urdf::Joint::CONTINUOUS)
-    {
-      upper_pos_limits(i) = std::nan("0");
-      lower_pos_limits(i) = std::nan("0");
-    }
-    else
-    {
-      // Non-existent urdf limits are zero initialized
-      upper_pos_limits(i) = robot_model.getJoint(m_joint_names[i])->limits->upper;
-      lower_pos_limits(i) = robot_model.getJoint(m_joint_names[i])->limits->lower;
-    }
+    const std::string error = ""
+      "Failed to get the joint limits of the controlled joints from robot_description";
+    ROS_ERROR_STREAM(error);
+    throw std::runtime_error(error);
   }
 
   // Get the joint handles to use in the control loop
@@ -176,11 +219,30 @@ init(HardwareInterface* hw, ros::NodeHandle& nh)
     m_joint_handles.push_back(hw->getHandle(m_joint_names[i]));
   }
 
+  // Preallocate command buffers for the realtime loop
+  m_simulated_joint_motion.resize(m_joint_names.size());
+  m_interpolation_start.resize(m_joint_names.size());
+  KDL::SetToZero(m_interpolation_start);
+  m_preview_motion.resize(m_joint_names.size());
+  m_preview_start.resize(m_joint_names.size());
+
   // Initialize solvers
-  m_ik_solver->init(nh, m_robot_chain,upper_pos_limits,lower_pos_limits);
-  KDL::Tree tmp("not_relevant");
-  tmp.addChain(m_robot_chain,"not_relevant");
-  m_forward_kinematics_solver.reset(new KDL::TreeFkSolverPos_recursive(tmp));
+  for (auto& solver : m_ik_solvers)
+  {
+    solver->init(nh, m_robot_chain,upper_pos_limits,lower_pos_limits);
+  }
+  m_end_effector_link_index = getLinkIndex(m_end_effector_link);
+
+  // Warm up each solver with a step from the current joint state, so that
+  // the first control cycle after starting or switching doesn't pay for any
+  // first-time work.
+  for (auto& solver : m_ik_solvers)
+  {
+    solver->setStartState(m_joint_handles);
+    solver->updateKinematics();
+    solver->getJointControlCmds(ros::Duration(0), ctrl::Vector6D::Zero(), m_simulated_joint_motion);
+  }
+  m_solver_handover = SolverRegistry::get(m_joint_names);
 
   // Initialize Cartesian pd controllers
   m_spatial_controller.init(nh);
@@ -194,6 +256,51 @@ init(HardwareInterface* hw, ros::NodeHandle& nh)
     std::make_shared<realtime_tools::RealtimePublisher<geometry_msgs::TwistStamped> >(
       nh, "current_twist", 3);
 
+  m_feedback_state_publisher =
+    std::make_shared<realtime_tools::RealtimePublisher<cartesian_controller_base::CartesianState> >(
+      nh, "current_state", 3);
+
+  // Optional state stream for local loggers in shared memory, named after
+  // the controller, e.g. /my_cartesian_motion_controller
+  bool state_stream = false;
+  int state_stream_size = 10000;
+  nh.getParam("state_stream", state_stream);
+  nh.getParam("state_stream_size", state_stream_size);
+  if (state_stream)
+  {
+    std::string name = nh.getNamespace();
+    std::replace(name.begin() + 1, name.end(), '/', '.');
+    if (!m_state_stream.init(name, std::max(state_stream_size, 1)))
+    {
+      ROS_WARN_STREAM("Continuing without state stream");
+    }
+  }
+
+  m_iteration_statistics_publisher =
+    std::make_shared<realtime_tools::RealtimePublisher<cartesian_controller_base::IterationStatistics> >(
+      nh, "iteration_statistics", 3);
+
+  // Preallocate the timing message, so that the realtime loop only copies
+  // numbers into it.
+  m_stage_timings_publisher =
+    std::make_shared<realtime_tools::RealtimePublisher<cartesian_controller_base::StageTimings> >(
+      nh, "stage_timings", 3);
+  m_stage_timings_publisher->lock();
+  m_stage_timings_publisher->msg_.stages = {
+    "synchronization",
+    "error_computation",
+    "pd_control",
+    "ik_solver",
+    "kinematics",
+    "write_commands",
+    "null_space"};
+  m_stage_timings_publisher->msg_.count.resize(NUMBER_OF_STAGES + 1);
+  m_stage_timings_publisher->msg_.min.resize(NUMBER_OF_STAGES + 1);
+  m_stage_timings_publisher->msg_.mean.resize(NUMBER_OF_STAGES + 1);
+  m_stage_timings_publisher->msg_.max.resize(NUMBER_OF_STAGES + 1);
+  m_stage_timings_publisher->msg_.p99.resize(NUMBER_OF_STAGES + 1);
+  m_stage_timings_publisher->unlock();
+
   // Connect dynamic reconfigure and overwrite the default values with values
   // on the parameter server. This is done automatically if parameters with
   // the according names exist.
@@ -207,17 +314,100 @@ init(HardwareInterface* hw, ros::NodeHandle& nh)
         ros::NodeHandle(nh.getNamespace() + "/solver")));
   m_dyn_conf_server->setCallback(m_callback_type);
 
+  // Each previewed solver cycle runs all iterations, so the preview costs up
+  // to preview_horizon x iterations extra solver steps per control cycle.
+  // Shorten the horizon if that exceeds the budget.
+  int preview_max_solver_steps = 100; // Default
+  nh.getParam("preview_max_solver_steps", preview_max_solver_steps);
+  if (m_preview_horizon * m_iterations > preview_max_solver_steps)
+  {
+    const int horizon = std::max(preview_max_solver_steps / m_iterations, 1);
+    ROS_WARN_STREAM("preview_horizon " << m_preview_horizon << " with " << m_iterations
+                    << " iterations exceeds preview_max_solver_steps " << preview_max_solver_steps
+                    << ". Previewing only " << horizon << " steps");
+    m_preview_horizon = horizon;
+  }
+
+  // Optionally run the solver on a dedicated worker thread, so that
+  // expensive steps don't delay other controllers of the controller manager.
+  bool async_solver = false;
+  int async_solver_cpu = -1;
+  int async_solver_priority = 0;
+  nh.getParam("async_solver", async_solver);
+  nh.getParam("async_solver_cpu", async_solver_cpu);
+  nh.getParam("async_solver_priority", async_solver_priority);
+  if (async_solver)
+  {
+    m_async_positions.resize(m_joint_names.size());
+    m_async_solver.reset(new AsyncWorker());
+    auto task = [this]()
+    {
+      AllocationTracker::Scope allocations(m_async_allocation_tracker.get());
+      m_solver_task(m_async_time);
+    };
+    if (!m_async_solver->init(task,
+                              async_solver_cpu, async_solver_priority))
+    {
+      ROS_WARN("Continuing with default scheduling for the asynchronous solver");
+    }
+  }
+
+  // Optionally count heap allocations in update() for debugging.  Only
+  // executables that link the allocation hooks see them.
+  bool track_allocations = false;
+  nh.getParam("track_allocations", track_allocations);
+  if (track_allocations)
+  {
+    if (!AllocationTracker::isHooked())
+    {
+      ROS_WARN_STREAM("Tracking allocations of " << nh.getNamespace()
+                      << ", but this process doesn't link the allocation hooks. Counts will stay zero.");
+    }
+    m_allocation_tracker.reset(new AllocationTracker(nh.getNamespace()));
+    if (m_async_solver)
+    {
+      m_async_allocation_tracker.reset(new AllocationTracker(nh.getNamespace() + " (async solver)"));
+    }
+  }
+
   m_already_initialized = true;
 
   return true;
 }
 
+template <class HardwareInterface>
+void CartesianControllerBase<HardwareInterface>::
+setSolverLoader(std::shared_ptr<pluginlib::ClassLoader<IKSolver> > solver_loader)
+{
+  m_solver_loader = solver_loader;
+}
+
 template <class HardwareInterface>
 void CartesianControllerBase<HardwareInterface>::
 starting(const ros::Time& time)
 {
-  // Copy joint state to internal simulation
-  m_ik_solver->setStartState(m_joint_handles);
+  // Forget about solutions and allocations of the last run
+  waitForSolver();
+  m_async_solution_pending = false;
+  m_async_solution_late = false;
+  resetAllocationTrackers();
+
+  // Use the most recently selected solver
+  m_active_ik_solver = m_requested_ik_solver;
+  m_ik_solver = m_ik_solvers[m_active_ik_solver];
+
+  // Copy joint state to internal simulation.  Continue the simulated
+  // velocities of a controller that just stopped on the same joints.
+  const IKSolver* previous = m_solver_handover->solver;
+  if (previous && previous != m_ik_solver.get() && m_solver_handover->stopped == time)
+  {
+    m_ik_solver->setState(*previous);
+    m_ik_solver->synchronizeJointPositions(m_joint_handles);
+  }
+  else
+  {
+    m_ik_solver->setStartState(m_joint_handles);
+  }
   m_ik_solver->updateKinematics();
 
   // Provide safe command buffers with starting where we are
@@ -225,106 +415,480 @@ starting(const ros::Time& time)
   writeJointControlCmds();
 }
 
-template <>
-void CartesianControllerBase<hardware_interface::PositionJointInterface>::
+template <class HardwareInterface>
+void CartesianControllerBase<HardwareInterface>::
+stopping(const ros::Time& time)
+{
+  waitForSolver();
+  m_solver_handover->stopped = time;
+  m_solver_handover->solver = m_ik_solver.get();
+
+  for (const AllocationTracker* tracker : {m_allocation_tracker.get(), m_async_allocation_tracker.get()})
+  {
+    if (!tracker)
+    {
+      continue;
+    }
+    if (tracker->getAllocations() > 0)
+    {
+      ROS_WARN_STREAM(tracker->report());
+    }
+    else
+    {
+      ROS_INFO_STREAM(tracker->report());
+    }
+  }
+}
+
+template <class HardwareInterface>
+void CartesianControllerBase<HardwareInterface>::
+resetAllocationTrackers()
+{
+  waitForSolver();
+  if (m_allocation_tracker)
+  {
+    m_allocation_tracker->reset();
+  }
+  if (m_async_allocation_tracker)
+  {
+    m_async_allocation_tracker->reset();
+  }
+}
+
+template <class HardwareInterface>
+bool CartesianControllerBase<HardwareInterface>::
+selectIKSolver(const std::string& name)
+{
+  auto solver = std::find(m_ik_solver_names.begin(), m_ik_solver_names.end(), name);
+  if (solver == m_ik_solver_names.end())
+  {
+    return false;
+  }
+  m_requested_ik_solver = solver - m_ik_solver_names.begin();
+  return true;
+}
+
+template <class HardwareInterface>
+void CartesianControllerBase<HardwareInterface>::
 writeJointControlCmds()
 {
-  if (m_publish_state_feedback)
+  if (m_publish_state_feedback || m_state_stream.isOpen())
   {
     publishStateFeedback();
   }
 
-  // Take position commands
+  if (m_interpolate_next_write)
+  {
+    // Spread the new solution over the next control cycles
+    m_interpolate_next_write = false;
+    m_interpolation_step = 1;
+  }
+  else
+  {
+    m_interpolation_step = m_interpolation_steps;
+  }
+  setJointCommands(static_cast<double>(m_interpolation_step) / m_interpolation_steps);
+  if (!m_preview_handles.empty())
+  {
+    writeJointPreview();
+  }
+
+  lapStageTimer(WRITE_COMMANDS);
+  publishStageTimings();
+}
+
+template <class HardwareInterface>
+bool CartesianControllerBase<HardwareInterface>::
+interpolateJointControlCmds()
+{
+  if (m_async_solver)
+  {
+    return false;  // The solver's results arrive late enough
+  }
+
+  if (m_interpolation_step < m_interpolation_steps)
+  {
+    ++m_interpolation_step;
+    setJointCommands(static_cast<double>(m_interpolation_step) / m_interpolation_steps);
+    return true;
+  }
+
+  // Time for the solver.  Its next solution is approached from the last one.
+  m_interpolation_steps = m_solver_decimation;
+  if (m_interpolation_steps > 1)
+  {
+    m_interpolation_start.q.data = m_simulated_joint_motion.q.data;
+    m_interpolation_start.qdot.data = m_simulated_joint_motion.qdot.data;
+    m_interpolate_next_write = true;
+  }
+  return false;
+}
+
+template <>
+void CartesianControllerBase<hardware_interface::PositionJointInterface>::
+setJointCommands(double progress)
+{
+  // Take position commands.  A progress of one gives exactly the solution.
   for (size_t i = 0; i < m_joint_handles.size(); ++i)
   {
-    m_joint_handles[i].setCommand(m_simulated_joint_motion.positions[i]);
+    m_joint_handles[i].setCommand(
+      (1.0 - progress) * m_interpolation_start.q(i) + progress * m_simulated_joint_motion.q(i));
   }
 }
 
 template <>
 void CartesianControllerBase<hardware_interface::VelocityJointInterface>::
-writeJointControlCmds()
+setJointCommands(double progress)
 {
-  if (m_publish_state_feedback)
+  // Take velocity commands
+  for (size_t i = 0; i < m_joint_handles.size(); ++i)
   {
-    publishStateFeedback();
+    m_joint_handles[i].setCommand(
+      (1.0 - progress) * m_interpolation_start.qdot(i) + progress * m_simulated_joint_motion.qdot(i));
   }
+}
 
-  // Take velocity commands
+template <class HardwareInterface>
+void CartesianControllerBase<HardwareInterface>::
+setSolverTask(const std::function<void(const ros::Time&)>& task)
+{
+  m_solver_task = task;
+}
+
+template <class HardwareInterface>
+void CartesianControllerBase<HardwareInterface>::
+setSolverSnapshot(const std::function<void()>& snapshot)
+{
+  m_solver_snapshot = snapshot;
+}
+
+template <class HardwareInterface>
+bool CartesianControllerBase<HardwareInterface>::
+solveAsynchronously(const ros::Time& time)
+{
+  if (!m_async_solver || !m_solver_task)
+  {
+    if (m_solver_snapshot)
+    {
+      m_solver_snapshot();
+    }
+    return false;
+  }
+
+  // Watchdog.  Don't wait for a late solution and don't use it either.
+  if (m_async_solver->isBusy())
+  {
+    holdJointCommands();
+    m_async_solution_late = true;
+    return true;
+  }
+
+  // Write the previous cycle's solution
+  if (m_async_solution_pending && !m_async_solution_late)
+  {
+    if (m_stage_timer_running)
+    {
+      m_stage_timer.start();  // Don't count the time since the solver finished
+    }
+    writeJointControlCmds();
+  }
+  m_async_solution_late = false;
+
+  // The worker doesn't touch the handles, which the hardware might update
+  // while it's busy.
+  for (size_t i = 0; i < m_joint_handles.size(); ++i)
+  {
+    m_async_positions(i) = m_joint_handles[i].getPosition();
+  }
+  m_async_time = time;
+  if (m_solver_snapshot)
+  {
+    m_solver_snapshot();
+  }
+  m_async_solution_pending = m_async_solver->start();
+  return true;
+}
+
+template <class HardwareInterface>
+void CartesianControllerBase<HardwareInterface>::
+waitForSolver()
+{
+  if (m_async_solver)
+  {
+    m_async_solver->wait();
+  }
+}
+
+template <>
+void CartesianControllerBase<hardware_interface::PositionJointInterface>::
+holdJointCommands()
+{
+  // The handles keep the last position commands
+}
+
+template <>
+void CartesianControllerBase<hardware_interface::VelocityJointInterface>::
+holdJointCommands()
+{
   for (size_t i = 0; i < m_joint_handles.size(); ++i)
   {
-    m_joint_handles[i].setCommand(m_simulated_joint_motion.velocities[i]);
+    m_joint_handles[i].setCommand(0.0);
   }
 }
 
+template <class HardwareInterface>
+void CartesianControllerBase<HardwareInterface>::
+writeJointPreview()
+{
+  // Continue the simulation as if the Cartesian input stayed the same.  The
+  // preview must not change the next real solver step, not even its timings.
+  m_ik_solver->saveState();
+  m_ik_solver->setNullSpaceTimings(nullptr);
+
+  // Step k is k + 1 control cycles ahead.  The commands first finish the
+  // interpolation towards the current solution.  Each following solver cycle
+  // simulates as many steps as update() does and is interpolated alike.
+  m_preview_start.q.data = m_interpolation_start.q.data;
+  m_preview_start.qdot.data = m_interpolation_start.qdot.data;
+  m_preview_motion.q.data = m_simulated_joint_motion.q.data;
+  m_preview_motion.qdot.data = m_simulated_joint_motion.qdot.data;
+  int steps = m_interpolation_steps;
+  int step = m_interpolation_step;
+  for (int k = 0; k < m_preview_horizon; ++k)
+  {
+    if (step >= steps)
+    {
+      m_preview_start.q.data = m_preview_motion.q.data;
+      m_preview_start.qdot.data = m_preview_motion.qdot.data;
+      for (int i = 0; i < m_iterations; ++i)
+      {
+        m_ik_solver->getJointControlCmds(m_last_period, m_cartesian_input, m_preview_motion);
+      }
+      steps = m_async_solver ? 1 : std::max(static_cast<int>(m_solver_decimation), 1);
+      step = 0;
+    }
+    ++step;
+
+    const double progress = static_cast<double>(step) / steps;
+    for (size_t i = 0; i < m_preview_handles.size(); ++i)
+    {
+      m_preview_handles[i].setPosition(k,
+          (1.0 - progress) * m_preview_start.q(i) + progress * m_preview_motion.q(i));
+      m_preview_handles[i].setVelocity(k,
+          (1.0 - progress) * m_preview_start.qdot(i) + progress * m_preview_motion.qdot(i));
+    }
+  }
+
+  m_ik_solver->setNullSpaceTimings(m_stage_timer_running ? &m_null_space_timings : nullptr);
+  m_ik_solver->restoreState();
+}
+
 template <class HardwareInterface>
 void CartesianControllerBase<HardwareInterface>::
 computeJointControlCmds(const ctrl::Vector6D& error, const ros::Duration& period)
 {
   // PD controlled system input
   m_cartesian_input = m_error_scale * m_spatial_controller(error,period);
+  lapStageTimer(PD_CONTROL);
 
   // Simulate one step forward
-  m_simulated_joint_motion = m_ik_solver->getJointControlCmds(
+  m_last_period = period;
+  m_ik_solver->getJointControlCmds(
       period,
-      m_cartesian_input);
+      m_cartesian_input,
+      m_simulated_joint_motion);
+  lapStageTimer(IK_SOLVER);
 
   m_ik_solver->updateKinematics();
+  lapStageTimer(KINEMATICS);
 }
 
 template <class HardwareInterface>
-ctrl::Vector6D CartesianControllerBase<HardwareInterface>::
-displayInBaseLink(const ctrl::Vector6D& vector, const std::string& from)
+void CartesianControllerBase<HardwareInterface>::
+synchronizeJointPositions()
 {
-  // Adjust format
-  KDL::Wrench wrench_kdl;
-  for (int i = 0; i < 6; ++i)
+  // Switch solvers on request.  The new solver continues the simulated
+  // motion of the previous one.
+  const int requested = m_requested_ik_solver;
+  if (requested != m_active_ik_solver)
   {
-    wrench_kdl(i) = vector[i];
+    m_ik_solvers[requested]->setState(*m_ik_solver);
+    m_ik_solvers[requested]->updateKinematics();
+    m_ik_solver = m_ik_solvers[requested];
+    m_active_ik_solver = requested;
   }
 
-  KDL::Frame transform_kdl;
-  m_forward_kinematics_solver->JntToCart(
-      m_ik_solver->getPositions(),
-      transform_kdl,
-      from);
+  if (m_async_solver)
+  {
+    m_ik_solver->synchronizeJointPositions(m_async_positions);
+  }
+  else
+  {
+    m_ik_solver->synchronizeJointPositions(m_joint_handles);
+  }
+}
 
-  // Rotate into new reference frame
-  wrench_kdl = transform_kdl.M * wrench_kdl;
+template <class HardwareInterface>
+void CartesianControllerBase<HardwareInterface>::
+startStageTimer()
+{
+  m_stage_timer_running = m_publish_stage_timings || m_collect_stage_timings;
+  if (m_stage_timer_running)
+  {
+    m_stage_timer.start();
+  }
+  m_ik_solver->setNullSpaceTimings(m_stage_timer_running ? &m_null_space_timings : nullptr);
+}
 
-  // Reassign
-  ctrl::Vector6D out;
-  for (int i = 0; i < 6; ++i)
+template <class HardwareInterface>
+void CartesianControllerBase<HardwareInterface>::
+lapStageTimer(Stage stage)
+{
+  if (m_stage_timer_running)
+  {
+    m_stage_timer.lap(stage);
+  }
+}
+
+template <class HardwareInterface>
+void CartesianControllerBase<HardwareInterface>::
+publishStageTimings()
+{
+  if (!m_stage_timer_running)
+  {
+    return;
+  }
+  m_stage_timer_running = false;
+  if (m_collect_stage_timings)
+  {
+    return;  // The owner reads them
+  }
+
+  // Summarize about one second of control cycles per message
+  const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  if (now - m_last_stage_timings < std::chrono::seconds(1))
+  {
+    return;
+  }
+
+  if (m_stage_timings_publisher->trylock()){
+    m_stage_timings_publisher->msg_.header.stamp = ros::Time::now();
+    for (int i = 0; i < NUMBER_OF_STAGES; ++i)
+    {
+      m_stage_timings_publisher->msg_.count[i] = m_stage_timer[i].count();
+      m_stage_timings_publisher->msg_.min[i] = m_stage_timer[i].min();
+      m_stage_timings_publisher->msg_.mean[i] = m_stage_timer[i].mean();
+      m_stage_timings_publisher->msg_.max[i] = m_stage_timer[i].max();
+      m_stage_timings_publisher->msg_.p99[i] = m_stage_timer[i].percentile(0.99);
+    }
+    m_stage_timings_publisher->msg_.count[NUMBER_OF_STAGES] = m_null_space_timings.count();
+    m_stage_timings_publisher->msg_.min[NUMBER_OF_STAGES] = m_null_space_timings.min();
+    m_stage_timings_publisher->msg_.mean[NUMBER_OF_STAGES] = m_null_space_timings.mean();
+    m_stage_timings_publisher->msg_.max[NUMBER_OF_STAGES] = m_null_space_timings.max();
+    m_stage_timings_publisher->msg_.p99[NUMBER_OF_STAGES] = m_null_space_timings.percentile(0.99);
+    m_stage_timings_publisher->unlockAndPublish();
+
+    m_stage_timer.reset();
+    m_null_space_timings.reset();
+    m_last_stage_timings = now;
+  }
+}
+
+template <class HardwareInterface>
+void CartesianControllerBase<HardwareInterface>::
+beginIterations()
+{
+  m_iterations_start = std::chrono::steady_clock::now();
+  m_iteration_start = m_iterations_start;
+  m_iterations_done = 0;
+  m_converged = false;
+}
+
+template <class HardwareInterface>
+bool CartesianControllerBase<HardwareInterface>::
+continueIterations(const ctrl::Vector6D& error)
+{
+  const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  m_last_error_norm = error.norm();
+
+  if (m_adaptive_iterations && m_iterations_done > 0)
+  {
+    if (m_last_error_norm < m_error_tolerance)
+    {
+      m_converged = true;
+      return false;
+    }
+
+    // Expect the next iteration to take as long as the last one.
+    const std::chrono::duration<double> elapsed = now - m_iterations_start;
+    const std::chrono::duration<double> last = now - m_iteration_start;
+    if ((elapsed + last).count() > m_time_budget)
+    {
+      return false;
+    }
+  }
+
+  m_iteration_start = now;
+  ++m_iterations_done;
+  return true;
+}
+
+template <class HardwareInterface>
+void CartesianControllerBase<HardwareInterface>::
+endIterations()
+{
+  if (!m_publish_state_feedback)
   {
-    out[i] = wrench_kdl(i);
+    return;
+  }
+
+  const std::chrono::duration<double> duration =
+    std::chrono::steady_clock::now() - m_iterations_start;
+
+  if (m_iteration_statistics_publisher->trylock()){
+    m_iteration_statistics_publisher->msg_.header.stamp = ros::Time::now();
+    m_iteration_statistics_publisher->msg_.iterations = m_iterations_done;
+    m_iteration_statistics_publisher->msg_.duration = duration.count();
+    m_iteration_statistics_publisher->msg_.error_norm = m_last_error_norm;
+    m_iteration_statistics_publisher->msg_.converged = m_converged;
+
+    m_iteration_statistics_publisher->unlockAndPublish();
   }
+}
 
+template <class HardwareInterface>
+ctrl::Vector6D CartesianControllerBase<HardwareInterface>::
+displayInBaseLink(const ctrl::Vector6D& vector, const std::string& from)
+{
+  return displayInBaseLink(vector, getLinkIndex(from));
+}
+
+template <class HardwareInterface>
+ctrl::Vector6D CartesianControllerBase<HardwareInterface>::
+displayInBaseLink(const ctrl::Vector6D& vector, int from)
+{
+  const ctrl::RotationMap R(m_ik_solver->getKinematics().getSegmentFrame(from).M.data);
+
+  // Rotate into new reference frame
+  ctrl::Vector6D out;
+  out.head<3>().noalias() = R * vector.head<3>();
+  out.tail<3>().noalias() = R * vector.tail<3>();
   return out;
 }
 
 template <class HardwareInterface>
 ctrl::Matrix6D CartesianControllerBase<HardwareInterface>::
 displayInBaseLink(const ctrl::Matrix6D& tensor, const std::string& from)
+{
+  return displayInBaseLink(tensor, getLinkIndex(from));
+}
+
+template <class HardwareInterface>
+ctrl::Matrix6D CartesianControllerBase<HardwareInterface>::
+displayInBaseLink(const ctrl::Matrix6D& tensor, int from)
 {
   // Get rotation to base
-  KDL::Frame R_kdl;
-  m_forward_kinematics_solver->JntToCart(
-      m_ik_solver->getPositions(),
-      R_kdl,
-      from);
-
-  // Adjust format
-  ctrl::Matrix3D R;
-  R <<
-      R_kdl.M.data[0],
-      R_kdl.M.data[1],
-      R_kdl.M.data[2],
-      R_kdl.M.data[3],
-      R_kdl.M.data[4],
-      R_kdl.M.data[5],
-      R_kdl.M.data[6],
-      R_kdl.M.data[7],
-      R_kdl.M.data[8];
+  const ctrl::RotationMap R(m_ik_solver->getKinematics().getSegmentFrame(from).M.data);
 
   // Treat diagonal blocks as individual 2nd rank tensors.
   // Display in base frame.
@@ -339,29 +903,19 @@ template <class HardwareInterface>
 ctrl::Vector6D CartesianControllerBase<HardwareInterface>::
 displayInTipLink(const ctrl::Vector6D& vector, const std::string& to)
 {
-  // Adjust format
-  KDL::Wrench wrench_kdl;
-  for (int i = 0; i < 6; ++i)
-  {
-    wrench_kdl(i) = vector[i];
-  }
+  return displayInTipLink(vector, getLinkIndex(to));
+}
 
-  KDL::Frame transform_kdl;
-  m_forward_kinematics_solver->JntToCart(
-      m_ik_solver->getPositions(),
-      transform_kdl,
-      to);
+template <class HardwareInterface>
+ctrl::Vector6D CartesianControllerBase<HardwareInterface>::
+displayInTipLink(const ctrl::Vector6D& vector, int to)
+{
+  const ctrl::RotationMap R(m_ik_solver->getKinematics().getSegmentFrame(to).M.data);
 
   // Rotate into new reference frame
-  wrench_kdl = transform_kdl.M.Inverse() * wrench_kdl;
-
-  // Reassign
   ctrl::Vector6D out;
-  for (int i = 0; i < 6; ++i)
-  {
-    out[i] = wrench_kdl(i);
-  }
-
+  out.head<3>().noalias() = R.transpose() * vector.head<3>();
+  out.tail<3>().noalias() = R.transpose() * vector.tail<3>();
   return out;
 }
 
@@ -369,10 +923,74 @@ template <class HardwareInterface>
 void CartesianControllerBase<HardwareInterface>::
 publishStateFeedback()
 {
+  const KDL::Frame& pose = m_ik_solver->getEndEffectorPose();
+  const ctrl::Vector6D& twist = m_ik_solver->getEndEffectorVel();
+  const ros::Time now = ros::Time::now();
+
+  // Every cycle for local loggers
+  if (m_state_stream.isOpen())
+  {
+    StateStream::Record& record = m_state_stream.beginWrite();
+    record.stamp = now.toNSec();
+    for (int i = 0; i < 3; ++i)
+    {
+      record.position[i] = pose.p(i);
+    }
+    for (int i = 0; i < 9; ++i)
+    {
+      record.rotation[i] = pose.M.data[i];
+    }
+    for (int i = 0; i < 6; ++i)
+    {
+      record.twist[i] = twist[i];
+      record.wrench[i] = m_feedback_wrench[i];
+    }
+    m_state_stream.commit();
+  }
+
+  // Only every n-th cycle on topics
+  if (!m_publish_state_feedback || ++m_state_feedback_cycle < m_state_feedback_decimation)
+  {
+    return;
+  }
+  m_state_feedback_cycle = 0;
+
+  if (m_combined_state_feedback)
+  {
+    if (m_feedback_state_publisher->trylock()){
+      cartesian_controller_base::CartesianState& msg = m_feedback_state_publisher->msg_;
+      msg.header.stamp = now;
+      msg.header.frame_id = m_robot_base_link;
+      msg.pose.position.x = pose.p.x();
+      msg.pose.position.y = pose.p.y();
+      msg.pose.position.z = pose.p.z();
+      pose.M.GetQuaternion(
+          msg.pose.orientation.x,
+          msg.pose.orientation.y,
+          msg.pose.orientation.z,
+          msg.pose.orientation.w
+          );
+      msg.twist.linear.x = twist[0];
+      msg.twist.linear.y = twist[1];
+      msg.twist.linear.z = twist[2];
+      msg.twist.angular.x = twist[3];
+      msg.twist.angular.y = twist[4];
+      msg.twist.angular.z = twist[5];
+      msg.wrench.force.x = m_feedback_wrench[0];
+      msg.wrench.force.y = m_feedback_wrench[1];
+      msg.wrench.force.z = m_feedback_wrench[2];
+      msg.wrench.torque.x = m_feedback_wrench[3];
+      msg.wrench.torque.y = m_feedback_wrench[4];
+      msg.wrench.torque.z = m_feedback_wrench[5];
+
+      m_feedback_state_publisher->unlockAndPublish();
+    }
+    return;
+  }
+
   // End-effector pose
-  auto pose = m_ik_solver->getEndEffectorPose();
   if (m_feedback_pose_publisher->trylock()){
-    m_feedback_pose_publisher->msg_.header.stamp = ros::Time::now();
+    m_feedback_pose_publisher->msg_.header.stamp = now;
     m_feedback_pose_publisher->msg_.header.frame_id = m_robot_base_link;
     m_feedback_pose_publisher->msg_.pose.position.x = pose.p.x();
     m_feedback_pose_publisher->msg_.pose.position.y = pose.p.y();
@@ -389,9 +1007,8 @@ publishStateFeedback()
   }
 
   // End-effector twist
-  auto twist = m_ik_solver->getEndEffectorVel();
   if (m_feedback_twist_publisher->trylock()){
-    m_feedback_twist_publisher->msg_.header.stamp = ros::Time::now();
+    m_feedback_twist_publisher->msg_.header.stamp = now;
     m_feedback_twist_publisher->msg_.header.frame_id = m_robot_base_link;
     m_feedback_twist_publisher->msg_.twist.linear.x = twist[0];
     m_feedback_twist_publisher->msg_.twist.linear.y = twist[1];
@@ -411,7 +1028,29 @@ dynamicReconfigureCallback(ControllerConfig& config, uint32_t level)
 {
   m_error_scale = config.error_scale;
   m_iterations = config.iterations;
+  m_adaptive_iterations = config.adaptive_iterations;
+  m_error_tolerance = config.error_tolerance;
+  m_time_budget = config.time_budget / 1000.0;
   m_publish_state_feedback = config.publish_state_feedback;
+  m_publish_stage_timings = config.publish_stage_timings;
+  m_state_feedback_decimation = config.state_feedback_decimation;
+  m_combined_state_feedback = config.combined_state_feedback;
+  m_solver_decimation = config.solver_decimation;
+  for (auto& solver : m_ik_solvers)
+  {
+    solver->setLimitAware(config.limit_aware);
+  }
+
+  // Select one of the preloaded IK solvers
+  if (!selectIKSolver(config.ik_solver))
+  {
+    if (!config.ik_solver.empty())
+    {
+      ROS_WARN_STREAM("IK solver " << config.ik_solver << " is not preloaded. "
+          << "Add it to the controller's ik_solvers parameter to switch to it.");
+    }
+    config.ik_solver = m_ik_solver_names[m_requested_ik_solver];
+  }
 }
 
 } // namespace
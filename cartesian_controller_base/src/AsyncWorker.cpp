@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    AsyncWorker.cpp
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+// this package
+#include <cartesian_controller_base/AsyncWorker.h>
+#include <cartesian_controller_base/WorkerPool.h>
+
+// other
+#include <cerrno>
+
+namespace cartesian_controller_base{
+
+  AsyncWorker::AsyncWorker()
+    : m_busy(false), m_running(false)
+  {
+  }
+
+  AsyncWorker::~AsyncWorker()
+  {
+    stop();
+  }
+
+  bool AsyncWorker::init(const std::function<void()>& task, int cpu, int priority)
+  {
+    stop();
+    m_task = task;
+    sem_init(&m_start, 0, 0);
+    m_running = true;
+    m_worker = std::thread(&AsyncWorker::work, this);
+    return configureWorkerThread(m_worker, "asynchronous worker", cpu, priority);
+  }
+
+  bool AsyncWorker::start()
+  {
+    if (!m_running || isBusy())
+    {
+      return false;
+    }
+    m_busy.store(true, std::memory_order_relaxed);
+    sem_post(&m_start);
+    return true;
+  }
+
+  void AsyncWorker::wait() const
+  {
+    while (isBusy())
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  void AsyncWorker::work()
+  {
+    while (true)
+    {
+      while (sem_wait(&m_start) != 0 && errno == EINTR)
+      {
+      }
+      if (!m_running)
+      {
+        return;
+      }
+      m_task();
+      m_busy.store(false, std::memory_order_release);
+    }
+  }
+
+  void AsyncWorker::stop()
+  {
+    if (!m_worker.joinable())
+    {
+      return;
+    }
+    wait();
+    m_running = false;
+    sem_post(&m_start);
+    m_worker.join();
+    sem_destroy(&m_start);
+  }
+
+} // namespace
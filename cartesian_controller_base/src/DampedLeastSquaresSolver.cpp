@@ -77,21 +77,28 @@ namespace cartesian_controller_base{
 
   DampedLeastSquaresSolver::~DampedLeastSquaresSolver(){}
 
-  trajectory_msgs::JointTrajectoryPoint DampedLeastSquaresSolver::getJointControlCmds(
+  void DampedLeastSquaresSolver::getJointControlCmds(
         ros::Duration period,
-        const ctrl::Vector6D& net_force)
+        const ctrl::Vector6D& net_force,
+        KDL::JntArrayVel& control_cmd)
   {
-    // Compute joint jacobian
-    m_jnt_jacobian_solver->JntToJac(m_current_positions,m_jnt_jacobian);
+    // Compute joint Jacobian
+    m_kinematics.update(m_current_positions);
 
     // Compute joint velocities according to:
     // \f$ \dot{q} = ( J^T J + \alpha^2 I )^{-1} J^T f \f$
-    ctrl::MatrixND identity;
-    identity.setIdentity(m_number_joints, m_number_joints);
-
-    m_current_velocities.data =
-      (m_jnt_jacobian.data.transpose() * m_jnt_jacobian.data
-       + m_alpha * m_alpha * identity).inverse() * m_jnt_jacobian.data.transpose() * net_force;
+    switch (m_number_joints)
+    {
+      case 6:
+        computeJointVelocities(net_force, m_workspace_6);
+        break;
+      case 7:
+        computeJointVelocities(net_force, m_workspace_7);
+        break;
+      default:
+        computeJointVelocities(net_force, m_workspace);
+        break;
+    }
 
     // Integrate once, starting with zero motion
     m_current_positions.data = m_last_positions.data + 0.5 * m_current_velocities.data * period.toSec();
@@ -100,22 +107,11 @@ namespace cartesian_controller_base{
     applyJointLimits();
 
     // Apply results
-    trajectory_msgs::JointTrajectoryPoint control_cmd;
-    for (int i = 0; i < m_number_joints; ++i)
-    {
-      control_cmd.positions.push_back(m_current_positions(i));
-      control_cmd.velocities.push_back(m_current_velocities(i));
-
-      // Accelerations should be left empty. Those values will be interpreted
-      // by most hardware joint drivers as max. tolerated values. As a
-      // consequence, the robot will move very slowly.
-    }
-    control_cmd.time_from_start = period; // valid for this duration
+    control_cmd.q = m_current_positions;
+    control_cmd.qdot = m_current_velocities;
 
     // Update for the next cycle
     m_last_positions = m_current_positions;
-
-    return control_cmd;
   }
 
   bool DampedLeastSquaresSolver::init(ros::NodeHandle& nh,
@@ -125,8 +121,17 @@ namespace cartesian_controller_base{
   {
     IKSolver::init(nh, chain, upper_pos_limits, lower_pos_limits);
 
-    m_jnt_jacobian_solver.reset(new KDL::ChainJntToJacSolver(m_chain));
-    m_jnt_jacobian.resize(m_number_joints);
+    // Only the dynamic workspace needs memory.  The fixed-size ones are used
+    // for six and seven joints.
+    switch (m_number_joints)
+    {
+      case 6:
+      case 7:
+        break;
+      default:
+        m_workspace.resize(m_number_joints);
+        break;
+    }
 
     // Connect dynamic reconfigure and overwrite the default values with values
     // on the parameter server. This is done automatically if parameters with
@@ -143,6 +148,50 @@ namespace cartesian_controller_base{
     return true;
   }
 
+  template <int Joints>
+  void DampedLeastSquaresSolver::computeJointVelocities(
+      const ctrl::Vector6D& net_force, Workspace<Joints>& workspace)
+  {
+    workspace.jacobian = m_kinematics.getJacobian().data;
+    if (updateSaturatedJoints(net_force))
+    {
+      deactivateSaturatedJoints(workspace.jacobian);
+    }
+
+    // Both this and the equivalent task space formulation below are
+    // symmetric and positive (semi-)definite, so we solve them with a Cholesky
+    // decomposition instead of inverting.
+    if (m_number_joints > 6)
+    {
+      // \f$ \dot{q} = J^T ( J J^T + \alpha^2 I )^{-1} f \f$
+      workspace.task_space_matrix.noalias() = workspace.jacobian * workspace.jacobian.transpose();
+      workspace.task_space_matrix.diagonal().array() += m_alpha * m_alpha;
+      workspace.task_space_ldlt.compute(workspace.task_space_matrix);
+      workspace.task_space_solution = workspace.task_space_ldlt.solve(net_force);
+      m_current_velocities.data.noalias() = workspace.jacobian.transpose() * workspace.task_space_solution;
+
+      // Project the secondary objective into the null space of J with the
+      // same decomposition:
+      // \f$ \dot{q}_0 - J^T ( J J^T + \alpha^2 I )^{-1} J \dot{q}_0 \f$
+      if (beginNullSpaceMotion())
+      {
+        workspace.task_space_solution.noalias() = workspace.jacobian * m_null_space_motion;
+        workspace.task_space_ldlt.solveInPlace(workspace.task_space_solution);
+        m_current_velocities.data += m_null_space_motion;
+        m_current_velocities.data.noalias() -= workspace.jacobian.transpose() * workspace.task_space_solution;
+        endNullSpaceMotion();
+      }
+    }
+    else
+    {
+      workspace.jnt_space_matrix.noalias() = workspace.jacobian.transpose() * workspace.jacobian;
+      workspace.jnt_space_matrix.diagonal().array() += m_alpha * m_alpha;
+      workspace.jnt_space_ldlt.compute(workspace.jnt_space_matrix);
+      workspace.jnt_torques.noalias() = workspace.jacobian.transpose() * net_force;
+      m_current_velocities.data = workspace.jnt_space_ldlt.solve(workspace.jnt_torques);
+    }
+  }
+
     void DampedLeastSquaresSolver::dynamicReconfigureCallback(IKConfig& config, uint32_t level)
     {
       m_alpha = config.alpha;
@@ -45,10 +45,6 @@
 #include <sstream>
 #include <eigen_conversions/eigen_kdl.h>
 
-// KDL
-#include <kdl/jntarrayvel.hpp>
-#include <kdl/framevel.hpp>
-
 // Pluginlib
 #include <pluginlib/class_list_macros.h>
 
@@ -69,6 +65,7 @@
  *         ...
  *         forward_dynamics:
  *             link_mass: 0.5
+ *             null_space_damping: 0.1
  * \endcode
  *
  */
@@ -86,48 +83,52 @@ namespace cartesian_controller_base{
 
   ForwardDynamicsSolver::~ForwardDynamicsSolver(){}
 
-  trajectory_msgs::JointTrajectoryPoint ForwardDynamicsSolver::getJointControlCmds(
+  void ForwardDynamicsSolver::getJointControlCmds(
         ros::Duration period,
-        const ctrl::Vector6D& net_force)
+        const ctrl::Vector6D& net_force,
+        KDL::JntArrayVel& control_cmd)
   {
+    // Compute joint space inertia matrix with actualized link masses.
+    // The generic model only needs an update after reconfiguration.
+    if (m_min != m_model_link_mass)
+    {
+      buildGenericModel();
+    }
 
-    // Compute joint space inertia matrix with actualized link masses
-    buildGenericModel();
-    m_jnt_space_inertia_solver->JntToMass(m_current_positions,m_jnt_space_inertia);
-
-    // Compute joint jacobian
-    m_jnt_jacobian_solver->JntToJac(m_current_positions,m_jnt_jacobian);
+    // Compute link frames and joint Jacobian in one pass
+    m_kinematics.update(m_current_positions);
+    computeJntSpaceInertia();
 
     // Compute joint accelerations according to: \f$ \ddot{q} = H^{-1} ( J^T f) \f$
-    m_current_accelerations.data = m_jnt_space_inertia.data.inverse() * m_jnt_jacobian.data.transpose() * net_force;
+    switch (m_number_joints)
+    {
+      case 6:
+        computeJointAccelerations(net_force, m_workspace_6);
+        break;
+      case 7:
+        computeJointAccelerations(net_force, m_workspace_7);
+        break;
+      default:
+        computeJointAccelerations(net_force, m_workspace);
+        break;
+    }
 
     // Numerical time integration with the Euler forward method
     m_current_positions.data = m_last_positions.data + m_last_velocities.data * period.toSec();
     m_current_velocities.data = m_last_velocities.data + m_current_accelerations.data * period.toSec();
-    m_current_velocities.data *= 0.9;  // 10 % global damping against unwanted null space motion.
-                                       // Will cause exponential slow-down without input.
+    m_current_velocities.data *= 1.0 - m_null_space_damping;  // Global damping against unwanted null space motion.
+                                                              // Will cause exponential slow-down without input.
 
     // Make sure positions stay in allowed margins
     applyJointLimits();
 
     // Apply results
-    trajectory_msgs::JointTrajectoryPoint control_cmd;
-    for (int i = 0; i < m_number_joints; ++i)
-    {
-      control_cmd.positions.push_back(m_current_positions(i));
-      control_cmd.velocities.push_back(m_current_velocities(i));
-
-      // Accelerations should be left empty. Those values will be interpreted
-      // by most hardware joint drivers as max. tolerated values. As a
-      // consequence, the robot will move very slowly.
-    }
-    control_cmd.time_from_start = period; // valid for this duration
+    control_cmd.q = m_current_positions;
+    control_cmd.qdot = m_current_velocities;
 
     // Update for the next cycle
     m_last_positions = m_current_positions;
     m_last_velocities = m_current_velocities;
-
-    return control_cmd;
   }
 
 
@@ -145,10 +146,20 @@ namespace cartesian_controller_base{
     }
 
     // Forward dynamics
-    m_jnt_jacobian_solver.reset(new KDL::ChainJntToJacSolver(m_chain));
-    m_jnt_space_inertia_solver.reset(new KDL::ChainDynParam(m_chain,KDL::Vector::Zero()));
-    m_jnt_jacobian.resize(m_number_joints);
     m_jnt_space_inertia.resize(m_number_joints);
+    m_body_jacobian.setZero(3, m_number_joints);
+
+    // Only the dynamic workspace needs memory.  The fixed-size ones are used
+    // for six and seven joints.
+    switch (m_number_joints)
+    {
+      case 6:
+      case 7:
+        break;
+      default:
+        m_workspace.resize(m_number_joints);
+        break;
+    }
 
     // Connect dynamic reconfigure and overwrite the default values with values
     // on the parameter server. This is done automatically if parameters with
@@ -172,6 +183,10 @@ namespace cartesian_controller_base{
 
   bool ForwardDynamicsSolver::buildGenericModel()
   {
+    // Remember which configuration this model represents.
+    // Dynamic reconfigure changes are detected against this value.
+    m_model_link_mass = m_min;
+
     // Set all masses and inertias to minimal (yet stable) values.
     double ip_min = 0.000001;
     for (size_t i = 0; i < m_chain.segments.size(); ++i)
@@ -186,7 +201,7 @@ namespace cartesian_controller_base{
       {
         m_chain.segments[i].setInertia(
             KDL::RigidBodyInertia(
-              m_min,                // mass
+              m_model_link_mass,    // mass
               KDL::Vector::Zero(),  // center of gravity
               KDL::RotationalInertia(
                 ip_min,             // ixx
@@ -210,9 +225,108 @@ namespace cartesian_controller_base{
     return true;
   }
 
+  template <int Joints>
+  void ForwardDynamicsSolver::computeJointAccelerations(
+      const ctrl::Vector6D& net_force, Workspace<Joints>& workspace)
+  {
+    workspace.jacobian = m_kinematics.getJacobian().data;
+
+    // Saturated joints are decoupled from the others, so that they don't
+    // accelerate through inertial coupling either.
+    if (updateSaturatedJoints(net_force))
+    {
+      deactivateSaturatedJoints(workspace.jacobian);
+      for (int i = 0; i < m_number_joints; ++i)
+      {
+        if (m_saturated_joints[i])
+        {
+          m_jnt_space_inertia.data.row(i).setZero();
+          m_jnt_space_inertia.data.col(i).setZero();
+          m_jnt_space_inertia.data(i, i) = 1.0;
+        }
+      }
+    }
+
+    // H is symmetric positive definite, so we solve with its Cholesky
+    // decomposition instead of inverting.
+    workspace.jnt_torques.noalias() = workspace.jacobian.transpose() * net_force;
+    workspace.jnt_space_inertia_llt.compute(m_jnt_space_inertia.data);
+    m_current_accelerations.data = workspace.jnt_space_inertia_llt.solve(workspace.jnt_torques);
+
+    // The secondary objective acts as joint torques.  Its accelerations are
+    // projected with the dynamically consistent null space projector
+    // \f$ I - H^{-1} J^T ( J H^{-1} J^T )^{-1} J \f$, reusing the
+    // decomposition of H.  The small regularization keeps this defined in
+    // singularities.
+    if (beginNullSpaceMotion())
+    {
+      workspace.inertia_jacobian = workspace.jnt_space_inertia_llt.solve(workspace.jacobian.transpose());
+      workspace.task_space_matrix.noalias() = workspace.jacobian * workspace.inertia_jacobian;
+      workspace.task_space_matrix.diagonal().array() += 1e-6;
+      workspace.task_space_ldlt.compute(workspace.task_space_matrix);
+      workspace.jnt_null_space_accelerations = workspace.jnt_space_inertia_llt.solve(m_null_space_motion);
+      workspace.task_space_solution.noalias() = workspace.jacobian * workspace.jnt_null_space_accelerations;
+      workspace.task_space_ldlt.solveInPlace(workspace.task_space_solution);
+      m_current_accelerations.data += workspace.jnt_null_space_accelerations;
+      m_current_accelerations.data.noalias() -= workspace.inertia_jacobian * workspace.task_space_solution;
+      endNullSpaceMotion();
+    }
+  }
+
+  void ForwardDynamicsSolver::computeJntSpaceInertia()
+  {
+    m_jnt_space_inertia.data.setZero();
+
+    // The generic model shares its geometry with the real chain, so we can
+    // reuse the link frames and the Jacobian of the current joint state.
+    const ctrl::Matrix6N<Eigen::Dynamic>& jacobian = m_kinematics.getJacobian().data;
+    const KDL::Vector& end_effector = m_kinematics.getEndEffectorPose().p;
+
+    int joint = 0;
+    for (size_t i = 0; i < m_chain.segments.size(); ++i)
+    {
+      const KDL::Segment& segment = m_chain.segments[i];
+      if (segment.getJoint().getType() != KDL::Joint::None)
+      {
+        ++joint;
+      }
+
+      // Bodies before the first joint don't contribute.
+      const KDL::RigidBodyInertia& inertia = segment.getInertia();
+      const double mass = inertia.getMass();
+      const double ip = (inertia.getRotationalInertia() * KDL::Vector(1, 0, 0)).x();  // isotropic
+      if (joint == 0 || (mass == 0.0 && ip == 0.0))
+      {
+        continue;
+      }
+
+      // Translational Jacobian of this body's center of mass, which the
+      // generic model places at the segment's tip.  Shift the reference point
+      // of the joint Jacobian from the end effector to there:
+      // \f$ J_v = V - [p]_\times W \f$
+      const KDL::Vector p = m_kinematics.getSegmentFrame(static_cast<int>(i)).p - end_effector;
+      ctrl::Matrix3D p_cross;
+      p_cross <<
+        0.0,    -p.z(),  p.y(),
+        p.z(),   0.0,   -p.x(),
+        -p.y(),  p.x(),  0.0;
+
+      auto v = jacobian.topLeftCorner(3, joint);
+      auto w = jacobian.bottomLeftCorner(3, joint);
+      auto jv = m_body_jacobian.leftCols(joint);
+      jv = v;
+      jv.noalias() -= p_cross * w;
+
+      auto h = m_jnt_space_inertia.data.topLeftCorner(joint, joint);
+      h.noalias() += mass * jv.transpose() * jv;
+      h.noalias() += ip * w.transpose() * w;
+    }
+  }
+
   void ForwardDynamicsSolver::dynamicReconfigureCallback(IKConfig& config, uint32_t level)
   {
     m_min = config.link_mass;
+    m_null_space_damping = config.null_space_damping;
   }
 
 
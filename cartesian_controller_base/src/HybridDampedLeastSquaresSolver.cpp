@@ -0,0 +1,356 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    HybridDampedLeastSquaresSolver.cpp
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+// this package
+#include <cartesian_controller_base/HybridDampedLeastSquaresSolver.h>
+
+// Pluginlib
+#include <pluginlib/class_list_macros.h>
+
+// Other
+#include <algorithm>
+#include <cmath>
+
+/**
+ * \class cartesian_controller_base::HybridDampedLeastSquaresSolver
+ *
+ * Users may explicitly specify this solver with \a "hybrid_damped_least_squares" as \a
+ * ik_solver in their controllers.yaml configuration file for each controller:
+ *
+ * \code{.yaml}
+ * <name_of_your_controller>:
+ *     type: "<type_of_your_controller>"
+ *     ik_solver: "hybrid_damped_least_squares"
+ *     ...
+ *
+ *     solver:
+ *         ...
+ *         hybrid_damped_least_squares:
+ *             damping_threshold: 0.05
+ *             max_damping: 0.1
+ *             sdls_threshold: 0.01
+ * \endcode
+ *
+ */
+PLUGINLIB_EXPORT_CLASS(cartesian_controller_base::HybridDampedLeastSquaresSolver, cartesian_controller_base::IKSolver)
+
+
+namespace cartesian_controller_base{
+
+  HybridDampedLeastSquaresSolver::HybridDampedLeastSquaresSolver()
+    : m_damping_threshold(0.05), m_max_damping(0.1), m_sdls_threshold(0.01),
+      m_singular_value(0.0), m_selective_damping(false), m_cold_start(true),
+      m_saved_singular_value(0.0), m_saved_selective_damping(false), m_saved_cold_start(true)
+  {
+  }
+
+  HybridDampedLeastSquaresSolver::~HybridDampedLeastSquaresSolver(){}
+
+  bool HybridDampedLeastSquaresSolver::setStartState(
+      const std::vector<hardware_interface::JointHandle>& joint_handles)
+  {
+    resetMode();
+    return SelectivelyDampedLeastSquaresSolver::setStartState(joint_handles);
+  }
+
+  void HybridDampedLeastSquaresSolver::setState(const IKSolver& other)
+  {
+    // The mode of the other solver, if any, belongs to its own thresholds
+    resetMode();
+    SelectivelyDampedLeastSquaresSolver::setState(other);
+  }
+
+  void HybridDampedLeastSquaresSolver::resetMode()
+  {
+    m_singular_value = 0.0;
+    m_selective_damping = false;
+    m_cold_start = true;
+    m_damped_6.direction.setConstant(1.0 / std::sqrt(m_damped_6.direction.size()));
+    m_damped_7.direction.setConstant(1.0 / std::sqrt(m_damped_7.direction.size()));
+    m_damped.direction.setConstant(1.0 / std::sqrt(m_damped.direction.size()));
+  }
+
+  void HybridDampedLeastSquaresSolver::saveState()
+  {
+    SelectivelyDampedLeastSquaresSolver::saveState();
+    m_saved_singular_value = m_singular_value;
+    m_saved_selective_damping = m_selective_damping;
+    m_saved_cold_start = m_cold_start;
+    switch (m_number_joints)
+    {
+      case 6:
+        m_saved_direction = m_damped_6.direction;
+        break;
+      case 7:
+        m_saved_direction = m_damped_7.direction;
+        break;
+      default:
+        m_saved_direction = m_damped.direction;
+        break;
+    }
+  }
+
+  void HybridDampedLeastSquaresSolver::restoreState()
+  {
+    SelectivelyDampedLeastSquaresSolver::restoreState();
+    m_singular_value = m_saved_singular_value;
+    m_selective_damping = m_saved_selective_damping;
+    m_cold_start = m_saved_cold_start;
+    switch (m_number_joints)
+    {
+      case 6:
+        m_damped_6.direction = m_saved_direction;
+        break;
+      case 7:
+        m_damped_7.direction = m_saved_direction;
+        break;
+      default:
+        m_damped.direction = m_saved_direction;
+        break;
+    }
+  }
+
+  void HybridDampedLeastSquaresSolver::getJointControlCmds(
+        ros::Duration period,
+        const ctrl::Vector6D& net_force,
+        KDL::JntArrayVel& control_cmd)
+  {
+    // Compute joint Jacobian
+    m_kinematics.update(m_current_positions);
+
+    switch (m_number_joints)
+    {
+      case 6:
+        computeJointVelocities(net_force, m_workspace_6, m_damped_6);
+        break;
+      case 7:
+        computeJointVelocities(net_force, m_workspace_7, m_damped_7);
+        break;
+      default:
+        computeJointVelocities(net_force, m_workspace, m_damped);
+        break;
+    }
+
+    // Integrate once, starting with zero motion
+    m_current_positions.data = m_last_positions.data + 0.5 * m_current_velocities.data * period.toSec();
+
+    // Make sure positions stay in allowed margins
+    applyJointLimits();
+
+    // Apply results
+    control_cmd.q = m_current_positions;
+    control_cmd.qdot = m_current_velocities;
+
+    // Update for the next cycle
+    m_last_positions = m_current_positions;
+  }
+
+  bool HybridDampedLeastSquaresSolver::init(ros::NodeHandle& nh,
+                                            const KDL::Chain& chain,
+                                            const KDL::JntArray& upper_pos_limits,
+                                            const KDL::JntArray& lower_pos_limits)
+  {
+    SelectivelyDampedLeastSquaresSolver::init(nh, chain, upper_pos_limits, lower_pos_limits);
+
+    switch (m_number_joints)
+    {
+      case 6:
+        m_damped_6.resize(6);
+        m_saved_direction = m_damped_6.direction;
+        break;
+      case 7:
+        m_damped_7.resize(7);
+        m_saved_direction = m_damped_7.direction;
+        break;
+      default:
+        m_damped.resize(m_number_joints);
+        m_saved_direction = m_damped.direction;
+        break;
+    }
+
+    // Connect dynamic reconfigure and overwrite the default values with values
+    // on the parameter server. This is done automatically if parameters with
+    // the according names exist.
+    m_callback_type = std::bind(&HybridDampedLeastSquaresSolver::dynamicReconfigureCallback,
+                                this,
+                                std::placeholders::_1,
+                                std::placeholders::_2);
+
+    m_dyn_conf_server.reset(
+        new dynamic_reconfigure::Server<IKConfig>(
+          ros::NodeHandle(nh.getNamespace() + "/solver/hybrid_damped_least_squares")));
+    m_dyn_conf_server->setCallback(m_callback_type);
+    return true;
+  }
+
+  template <int Joints>
+  void HybridDampedLeastSquaresSolver::computeJointVelocities(
+      const ctrl::Vector6D& net_force,
+      Workspace<Joints>& workspace,
+      DampedWorkspace<Joints>& damped)
+  {
+    workspace.jacobian = m_kinematics.getJacobian().data;
+    if (updateSaturatedJoints(net_force))
+    {
+      deactivateSaturatedJoints(workspace.jacobian);
+    }
+
+    // Factorize the undamped system, which gives the singular value estimate
+    // for free.  Without damping, this is also the final solution.
+    if (!m_selective_damping)
+    {
+      if (m_number_joints > 6)
+      {
+        damped.matrix.noalias() = workspace.jacobian * workspace.jacobian.transpose();
+      }
+      else
+      {
+        damped.matrix.noalias() = workspace.jacobian.transpose() * workspace.jacobian;
+
+        // Saturated joints get zero torques. Keep them from making the
+        // system singular.
+        for (int i = 0; i < m_number_joints; ++i)
+        {
+          if (m_saturated_joints[i])
+          {
+            damped.matrix(i, i) = 1.0;
+          }
+        }
+      }
+      damped.ldlt.compute(damped.matrix);
+      m_singular_value = estimateSingularValue(damped);
+
+      // Without a warm start, one step may overestimate a lot.  Each step
+      // gives an upper bound, so the smallest one is the best.
+      for (int i = 1; m_cold_start && i < COLD_START_ITERATIONS; ++i)
+      {
+        m_singular_value = std::min(m_singular_value, estimateSingularValue(damped));
+      }
+      m_cold_start = false;
+      m_selective_damping = m_singular_value < m_sdls_threshold;
+    }
+
+    if (m_selective_damping)
+    {
+      solveSelectivelyDamped(net_force, workspace);
+
+      // Switch back with some hysteresis, so that both methods don't
+      // alternate around the threshold.
+      m_singular_value = getSelectiveSingularValue(workspace);
+      m_selective_damping = m_singular_value < 1.5 * m_sdls_threshold;
+      return;
+    }
+
+    // Adaptive damping
+    if (m_singular_value < m_damping_threshold)
+    {
+      const double ratio = m_singular_value / m_damping_threshold;
+      damped.matrix.diagonal().array() += (1.0 - ratio * ratio) * m_max_damping * m_max_damping;
+      damped.ldlt.compute(damped.matrix);
+    }
+
+    if (m_number_joints > 6)
+    {
+      // \f$ \dot{q} = J^T ( J J^T + \lambda^2 I )^{-1} f \f$
+      damped.rhs = damped.ldlt.solve(net_force);
+      m_current_velocities.data.noalias() = workspace.jacobian.transpose() * damped.rhs;
+
+      // \f$ \dot{q}_0 - J^T ( J J^T + \lambda^2 I )^{-1} J \dot{q}_0 \f$
+      if (beginNullSpaceMotion())
+      {
+        damped.rhs.noalias() = workspace.jacobian * m_null_space_motion;
+        damped.ldlt.solveInPlace(damped.rhs);
+        m_current_velocities.data += m_null_space_motion;
+        m_current_velocities.data.noalias() -= workspace.jacobian.transpose() * damped.rhs;
+        endNullSpaceMotion();
+      }
+    }
+    else
+    {
+      // \f$ \dot{q} = ( J^T J + \lambda^2 I )^{-1} J^T f \f$
+      damped.jnt_torques.noalias() = workspace.jacobian.transpose() * net_force;
+      m_current_velocities.data = damped.ldlt.solve(damped.jnt_torques);
+    }
+  }
+
+  template <int Joints>
+  double HybridDampedLeastSquaresSolver::estimateSingularValue(DampedWorkspace<Joints>& damped)
+  {
+    // Each pivot is a Schur complement of the system matrix, which is never
+    // smaller than its smallest eigenvalue.
+    const double pivot = damped.ldlt.vectorD().minCoeff();
+    if (damped.ldlt.info() != Eigen::Success || !(pivot > 0.0))
+    {
+      return 0.0;
+    }
+
+    // One step of inverse iteration with a unit start vector
+    damped.rhs = damped.ldlt.solve(damped.direction);
+    const double norm = damped.rhs.norm();
+    if (!std::isfinite(norm))
+    {
+      damped.direction.setConstant(1.0 / std::sqrt(damped.direction.size()));
+      return 0.0;
+    }
+    damped.direction = damped.rhs / norm;
+
+    return std::sqrt(std::min(pivot, 1.0 / norm));
+  }
+
+  template <int Joints>
+  double HybridDampedLeastSquaresSolver::getSelectiveSingularValue(const Workspace<Joints>& workspace) const
+  {
+    // Saturated joints don't count towards the rank of J
+    const int active = std::count(m_saturated_joints.begin(), m_saturated_joints.end(), false);
+    const int rank = std::min(active, 6);
+    if (rank == 0)
+    {
+      return 0.0;
+    }
+    const ctrl::Vector6D& s_squared = workspace.eigen_solver.eigenvalues();  // ascending
+    return std::sqrt(std::max(s_squared[6 - rank], 0.0));
+  }
+
+  void HybridDampedLeastSquaresSolver::dynamicReconfigureCallback(IKConfig& config, uint32_t level)
+  {
+    m_damping_threshold = config.damping_threshold;
+    m_max_damping = config.max_damping;
+    m_sdls_threshold = config.sdls_threshold;
+  }
+
+} // namespace
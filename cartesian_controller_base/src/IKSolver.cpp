@@ -46,22 +46,40 @@
 #include <algorithm>
 #include <eigen_conversions/eigen_kdl.h>
 
-// KDL
-#include <kdl/jntarrayvel.hpp>
-#include <kdl/framevel.hpp>
-
 // DEBUG
 
 
 namespace cartesian_controller_base{
 
   IKSolver::IKSolver()
+    : m_limit_aware(false), m_null_space_timings(nullptr)
   {
   }
 
   IKSolver::~IKSolver(){}
 
 
+  trajectory_msgs::JointTrajectoryPoint IKSolver::getJointControlCmds(
+        ros::Duration period,
+        const ctrl::Vector6D& net_force)
+  {
+    KDL::JntArrayVel cmds(m_number_joints);
+    getJointControlCmds(period, net_force, cmds);
+
+    // Accelerations should be left empty. Those values will be interpreted
+    // by most hardware joint drivers as max. tolerated values. As a
+    // consequence, the robot will move very slowly.
+    trajectory_msgs::JointTrajectoryPoint control_cmd;
+    for (int i = 0; i < m_number_joints; ++i)
+    {
+      control_cmd.positions.push_back(cmds.q(i));
+      control_cmd.velocities.push_back(cmds.qdot(i));
+    }
+    control_cmd.time_from_start = period; // valid for this duration
+
+    return control_cmd;
+  }
+
   const KDL::Frame& IKSolver::getEndEffectorPose() const
   {
     return m_end_effector_pose;
@@ -78,6 +96,18 @@ namespace cartesian_controller_base{
   }
 
 
+  const KinematicsCache& IKSolver::getKinematics()
+  {
+    m_kinematics.update(m_current_positions);
+    return m_kinematics;
+  }
+
+  int IKSolver::getSegmentIndex(const std::string& name) const
+  {
+    return m_kinematics.getSegmentIndex(name);
+  }
+
+
   bool IKSolver::setStartState(
       const std::vector<hardware_interface::JointHandle>& joint_handles)
   {
@@ -104,6 +134,43 @@ namespace cartesian_controller_base{
     }
   }
 
+  void IKSolver::synchronizeJointPositions(const KDL::JntArray& positions)
+  {
+    m_current_positions.data = positions.data;
+    m_last_positions.data    = positions.data;
+  }
+
+
+  void IKSolver::setState(const IKSolver& other)
+  {
+    // Equally sized buffers, so no reallocation here.
+    m_current_positions.data      = other.m_current_positions.data;
+    m_current_velocities.data     = other.m_current_velocities.data;
+    m_current_accelerations.data  = other.m_current_accelerations.data;
+    m_last_positions.data         = other.m_last_positions.data;
+    m_last_velocities.data        = other.m_last_velocities.data;
+  }
+
+  void IKSolver::saveState()
+  {
+    m_saved_positions.data        = m_current_positions.data;
+    m_saved_velocities.data       = m_current_velocities.data;
+    m_saved_accelerations.data    = m_current_accelerations.data;
+    m_saved_last_positions.data   = m_last_positions.data;
+    m_saved_last_velocities.data  = m_last_velocities.data;
+    m_saved_saturated_joints      = m_saturated_joints;
+  }
+
+  void IKSolver::restoreState()
+  {
+    m_current_positions.data      = m_saved_positions.data;
+    m_current_velocities.data     = m_saved_velocities.data;
+    m_current_accelerations.data  = m_saved_accelerations.data;
+    m_last_positions.data         = m_saved_last_positions.data;
+    m_last_velocities.data        = m_saved_last_velocities.data;
+    m_saturated_joints            = m_saved_saturated_joints;
+  }
+
 
   bool IKSolver::init(ros::NodeHandle& nh,
                       const KDL::Chain& chain,
@@ -118,12 +185,50 @@ namespace cartesian_controller_base{
     m_current_accelerations.data = ctrl::VectorND::Zero(m_number_joints);
     m_last_positions.data        = ctrl::VectorND::Zero(m_number_joints);
     m_last_velocities.data       = ctrl::VectorND::Zero(m_number_joints);
+    m_saved_positions            = m_current_positions;
+    m_saved_velocities           = m_current_velocities;
+    m_saved_accelerations        = m_current_accelerations;
+    m_saved_last_positions       = m_last_positions;
+    m_saved_last_velocities      = m_last_velocities;
     m_upper_pos_limits           = upper_pos_limits;
     m_lower_pos_limits           = lower_pos_limits;
 
+    // Continuous joints are marked with NaN limits
+    m_continuous_joints.resize(m_number_joints);
+    m_saturated_joints.assign(m_number_joints, false);
+    m_saved_saturated_joints = m_saturated_joints;
+    for (int i = 0; i < m_number_joints; ++i)
+    {
+      m_continuous_joints[i] = std::isnan(m_lower_pos_limits(i)) || std::isnan(m_upper_pos_limits(i));
+    }
+
     // Forward kinematics
-    m_fk_pos_solver.reset(new KDL::ChainFkSolverPos_recursive(m_chain));
-    m_fk_vel_solver.reset(new KDL::ChainFkSolverVel_recursive(m_chain));
+    m_kinematics.init(m_chain);
+
+    // Optional secondary objective for redundant robots
+    m_null_space_motion = ctrl::VectorND::Zero(m_number_joints);
+    ros::NodeHandle null_space_nh(nh.getNamespace() + "/solver/null_space");
+    std::string objective;
+    null_space_nh.getParam("objective", objective);
+    if (!objective.empty())
+    {
+      try
+      {
+        m_null_space_loader.reset(new pluginlib::ClassLoader<NullSpaceObjective>(
+          "cartesian_controller_base", "cartesian_controller_base::NullSpaceObjective"));
+        m_null_space_objective = m_null_space_loader->createInstance(objective);
+      }
+      catch (pluginlib::PluginlibException& ex)
+      {
+        ROS_ERROR_STREAM(ex.what());
+        return false;
+      }
+      if (!m_null_space_objective->init(null_space_nh, m_chain, m_upper_pos_limits, m_lower_pos_limits))
+      {
+        ROS_ERROR_STREAM("Failed to initialize null space objective " << objective);
+        return false;
+      }
+    }
 
     return true;
   }
@@ -131,31 +236,104 @@ namespace cartesian_controller_base{
   void IKSolver::updateKinematics()
   {
     // Pose w. r. t. base
-    m_fk_pos_solver->JntToCart(m_current_positions,m_end_effector_pose);
+    m_kinematics.update(m_current_positions);
+    m_end_effector_pose = m_kinematics.getEndEffectorPose();
 
     // Absolute velocity w. r. t. base
-    KDL::FrameVel vel;
-    m_fk_vel_solver->JntToCart(KDL::JntArrayVel(m_current_positions,m_current_velocities),vel);
-    m_end_effector_vel[0] = vel.deriv().vel.x();
-    m_end_effector_vel[1] = vel.deriv().vel.y();
-    m_end_effector_vel[2] = vel.deriv().vel.z();
-    m_end_effector_vel[3] = vel.deriv().rot.x();
-    m_end_effector_vel[4] = vel.deriv().rot.y();
-    m_end_effector_vel[5] = vel.deriv().rot.z();
+    m_end_effector_vel.noalias() = m_kinematics.getJacobian().data * m_current_velocities.data;
+  }
+
+  bool IKSolver::hasNullSpaceObjective() const
+  {
+    return static_cast<bool>(m_null_space_objective);
+  }
+
+  void IKSolver::setNullSpaceTimings(StageStatistics* timings)
+  {
+    m_null_space_timings = timings;
+  }
+
+  bool IKSolver::beginNullSpaceMotion()
+  {
+    if (!m_null_space_objective)
+    {
+      return false;
+    }
+    if (m_null_space_timings)
+    {
+      m_null_space_start = std::chrono::steady_clock::now();
+    }
+    m_null_space_objective->computeMotion(
+        m_current_positions, m_kinematics.getJacobian(), m_null_space_motion);
+    for (int i = 0; i < m_number_joints; ++i)
+    {
+      if (m_saturated_joints[i])
+      {
+        m_null_space_motion[i] = 0.0;
+      }
+    }
+    return true;
+  }
+
+  void IKSolver::endNullSpaceMotion()
+  {
+    if (m_null_space_timings)
+    {
+      m_null_space_timings->record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - m_null_space_start).count());
+    }
+  }
+
+  void IKSolver::setLimitAware(bool limit_aware)
+  {
+    m_limit_aware = limit_aware;
   }
 
   void IKSolver::applyJointLimits()
   {
+    const bool limit_aware = m_limit_aware;
     for (int i = 0; i < m_number_joints; ++i)
     {
-      if (std::isnan(m_lower_pos_limits(i)) || std::isnan(m_upper_pos_limits(i)))
+      if (m_continuous_joints[i])
       {
-        // Joint marked as continuous.
         continue;
       }
+      const double position = m_current_positions(i);
       m_current_positions(i) = std::clamp(
-          m_current_positions(i),m_lower_pos_limits(i),m_upper_pos_limits(i));
+          position,m_lower_pos_limits(i),m_upper_pos_limits(i));
+
+      // Don't keep running into the limit in the next step
+      if (limit_aware && m_current_positions(i) != position)
+      {
+        m_current_velocities(i) = 0.0;
+      }
+    }
+  }
+
+  bool IKSolver::updateSaturatedJoints(const ctrl::Vector6D& net_force)
+  {
+    if (!m_limit_aware)
+    {
+      std::fill(m_saturated_joints.begin(), m_saturated_joints.end(), false);
+      return false;
+    }
+
+    const KDL::Jacobian& jacobian = m_kinematics.getJacobian();
+    bool saturated = false;
+    for (int i = 0; i < m_number_joints; ++i)
+    {
+      if (m_continuous_joints[i])
+      {
+        m_saturated_joints[i] = false;
+        continue;
+      }
+      const double torque = jacobian.data.col(i).dot(net_force);
+      m_saturated_joints[i] =
+        (m_current_positions(i) >= m_upper_pos_limits(i) && torque > 0.0) ||
+        (m_current_positions(i) <= m_lower_pos_limits(i) && torque < 0.0);
+      saturated = saturated || m_saturated_joints[i];
     }
+    return saturated;
   }
 
 } // namespace
@@ -71,15 +71,39 @@ namespace cartesian_controller_base{
 
   JacobianTransposeSolver::~JacobianTransposeSolver(){}
 
-  trajectory_msgs::JointTrajectoryPoint JacobianTransposeSolver::getJointControlCmds(
+  void JacobianTransposeSolver::getJointControlCmds(
         ros::Duration period,
-        const ctrl::Vector6D& net_force)
+        const ctrl::Vector6D& net_force,
+        KDL::JntArrayVel& control_cmd)
   {
-    // Compute joint jacobian
-    m_jnt_jacobian_solver->JntToJac(m_current_positions,m_jnt_jacobian);
+    // Compute joint Jacobian
+    m_kinematics.update(m_current_positions);
 
     // Compute joint accelerations according to: \f$ \ddot{q} = H^{-1} ( J^T f) \f$
-    m_current_accelerations.data = m_jnt_jacobian.data.transpose() * net_force;
+    const bool saturated = updateSaturatedJoints(net_force);
+    if (saturated)
+    {
+      m_active_jacobian = m_kinematics.getJacobian().data;
+      deactivateSaturatedJoints(m_active_jacobian);
+    }
+    const ctrl::Matrix6N<Eigen::Dynamic>& jacobian =
+      saturated ? m_active_jacobian : m_kinematics.getJacobian().data;
+    m_current_accelerations.data.noalias() = jacobian.transpose() * net_force;
+
+    // Project the secondary objective into the null space of J:
+    // \f$ \ddot{q}_0 - J^T ( J J^T )^{-1} J \ddot{q}_0 \f$
+    // The small regularization keeps this defined in singularities.
+    if (beginNullSpaceMotion())
+    {
+      m_task_space_matrix.noalias() = jacobian * jacobian.transpose();
+      m_task_space_matrix.diagonal().array() += 1e-6;
+      m_task_space_ldlt.compute(m_task_space_matrix);
+      m_task_space_solution.noalias() = jacobian * m_null_space_motion;
+      m_task_space_ldlt.solveInPlace(m_task_space_solution);
+      m_current_accelerations.data += m_null_space_motion;
+      m_current_accelerations.data.noalias() -= jacobian.transpose() * m_task_space_solution;
+      endNullSpaceMotion();
+    }
 
     // Integrate once, starting with zero motion
     m_current_velocities.data = 0.5 * m_current_accelerations.data * period.toSec();
@@ -91,22 +115,11 @@ namespace cartesian_controller_base{
     applyJointLimits();
 
     // Apply results
-    trajectory_msgs::JointTrajectoryPoint control_cmd;
-    for (int i = 0; i < m_number_joints; ++i)
-    {
-      control_cmd.positions.push_back(m_current_positions(i));
-      control_cmd.velocities.push_back(m_current_velocities(i));
-
-      // Accelerations should be left empty. Those values will be interpreted
-      // by most hardware joint drivers as max. tolerated values. As a
-      // consequence, the robot will move very slowly.
-    }
-    control_cmd.time_from_start = period; // valid for this duration
+    control_cmd.q = m_current_positions;
+    control_cmd.qdot = m_current_velocities;
 
     // Update for the next cycle
     m_last_positions = m_current_positions;
-
-    return control_cmd;
   }
 
   bool JacobianTransposeSolver::init(ros::NodeHandle& nh,
@@ -116,8 +129,7 @@ namespace cartesian_controller_base{
   {
     IKSolver::init(nh, chain, upper_pos_limits, lower_pos_limits);
 
-    m_jnt_jacobian_solver.reset(new KDL::ChainJntToJacSolver(m_chain));
-    m_jnt_jacobian.resize(m_number_joints);
+    m_active_jacobian.setZero(6, m_number_joints);
 
     return true;
   }
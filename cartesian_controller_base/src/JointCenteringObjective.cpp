@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    JointCenteringObjective.cpp
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+// this package
+#include <cartesian_controller_base/JointCenteringObjective.h>
+
+// other
+#include <cmath>
+
+// Pluginlib
+#include <pluginlib/class_list_macros.h>
+
+/**
+ * \class cartesian_controller_base::JointCenteringObjective
+ *
+ * Users may specify this objective with \a "joint_centering" in the solver's
+ * null space configuration:
+ *
+ * \code{.yaml}
+ * <name_of_your_controller>:
+ *     ...
+ *     solver:
+ *         null_space:
+ *             objective: "joint_centering"
+ *             gain: 1.0
+ * \endcode
+ *
+ */
+PLUGINLIB_EXPORT_CLASS(cartesian_controller_base::JointCenteringObjective, cartesian_controller_base::NullSpaceObjective)
+
+namespace cartesian_controller_base{
+
+  JointCenteringObjective::JointCenteringObjective()
+  {
+  }
+
+  JointCenteringObjective::~JointCenteringObjective(){}
+
+  bool JointCenteringObjective::init(ros::NodeHandle& nh,
+                                     const KDL::Chain& chain,
+                                     const KDL::JntArray& upper_pos_limits,
+                                     const KDL::JntArray& lower_pos_limits)
+  {
+    NullSpaceObjective::init(nh, chain, upper_pos_limits, lower_pos_limits);
+
+    const int joints = chain.getNrOfJoints();
+    m_center = ctrl::VectorND::Zero(joints);
+    m_weights = ctrl::VectorND::Zero(joints);
+    for (int i = 0; i < joints; ++i)
+    {
+      const double range = upper_pos_limits(i) - lower_pos_limits(i);
+      if (std::isnan(range) || range <= 0.0)
+      {
+        continue;  // Continuous or without limits
+      }
+      m_center[i] = 0.5 * (upper_pos_limits(i) + lower_pos_limits(i));
+      m_weights[i] = 1.0 / (range * range);
+    }
+    return true;
+  }
+
+  void JointCenteringObjective::computeMotion(const KDL::JntArray& positions,
+                                              const KDL::Jacobian& jacobian,
+                                              ctrl::VectorND& motion)
+  {
+    motion = -m_gain * m_weights.cwiseProduct(positions.data - m_center);
+  }
+
+} // namespace
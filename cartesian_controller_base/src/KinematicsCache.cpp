@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    KinematicsCache.cpp
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+// this package
+#include <cartesian_controller_base/KinematicsCache.h>
+
+namespace cartesian_controller_base{
+
+  KinematicsCache::KinematicsCache()
+    : m_root(KDL::Frame::Identity()), m_valid(false)
+  {
+  }
+
+  KinematicsCache::~KinematicsCache(){}
+
+  void KinematicsCache::init(const KDL::Chain& chain)
+  {
+    m_chain = chain;
+    m_positions.resize(m_chain.getNrOfJoints());
+    m_segment_frames.resize(m_chain.getNrOfSegments(), KDL::Frame::Identity());
+    m_jacobian.resize(m_chain.getNrOfJoints());
+    m_valid = false;
+  }
+
+  bool KinematicsCache::update(const KDL::JntArray& positions)
+  {
+    if (m_valid && positions.data == m_positions.data)
+    {
+      return false;
+    }
+    m_positions = positions;
+
+    // Frames and joint twists in one pass.  Each twist is first taken with the
+    // root's origin as reference point and shifted to the end effector at the
+    // end.
+    KDL::Frame frame = KDL::Frame::Identity();
+    unsigned int joint = 0;
+    for (size_t i = 0; i < m_chain.segments.size(); ++i)
+    {
+      const KDL::Segment& segment = m_chain.segments[i];
+
+      if (segment.getJoint().getType() != KDL::Joint::None)
+      {
+        KDL::Twist twist = frame.M * segment.twist(m_positions(joint), 1.0);
+        frame = frame * segment.pose(m_positions(joint));
+        m_jacobian.setColumn(joint, twist.RefPoint(-frame.p));
+        ++joint;
+      }
+      else
+      {
+        frame = frame * segment.pose(0.0);
+      }
+      m_segment_frames[i] = frame;
+    }
+    m_jacobian.changeRefPoint(getEndEffectorPose().p);
+
+    m_valid = true;
+    return true;
+  }
+
+  const KDL::Frame& KinematicsCache::getEndEffectorPose() const
+  {
+    return getSegmentFrame(static_cast<int>(m_segment_frames.size()) - 1);
+  }
+
+  const KDL::Jacobian& KinematicsCache::getJacobian() const
+  {
+    return m_jacobian;
+  }
+
+  int KinematicsCache::getSegmentIndex(const std::string& name) const
+  {
+    for (size_t i = 0; i < m_chain.segments.size(); ++i)
+    {
+      if (m_chain.segments[i].getName() == name)
+      {
+        return static_cast<int>(i);
+      }
+    }
+    return -1;
+  }
+
+  const KDL::Frame& KinematicsCache::getSegmentFrame(int index) const
+  {
+    if (index < 0)
+    {
+      return m_root;
+    }
+    return m_segment_frames[index];
+  }
+
+  const KDL::Frame& KinematicsCache::getSegmentFrame(const std::string& name) const
+  {
+    return getSegmentFrame(getSegmentIndex(name));
+  }
+
+} // namespace
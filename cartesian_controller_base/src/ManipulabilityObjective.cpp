@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    ManipulabilityObjective.cpp
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+// this package
+#include <cartesian_controller_base/ManipulabilityObjective.h>
+
+// other
+#include <cmath>
+
+// Pluginlib
+#include <pluginlib/class_list_macros.h>
+
+/**
+ * \class cartesian_controller_base::ManipulabilityObjective
+ *
+ * Users may specify this objective with \a "manipulability" in the solver's
+ * null space configuration:
+ *
+ * \code{.yaml}
+ * <name_of_your_controller>:
+ *     ...
+ *     solver:
+ *         null_space:
+ *             objective: "manipulability"
+ *             gain: 1.0
+ * \endcode
+ *
+ */
+PLUGINLIB_EXPORT_CLASS(cartesian_controller_base::ManipulabilityObjective, cartesian_controller_base::NullSpaceObjective)
+
+namespace cartesian_controller_base{
+
+  ManipulabilityObjective::ManipulabilityObjective()
+  {
+  }
+
+  ManipulabilityObjective::~ManipulabilityObjective(){}
+
+  bool ManipulabilityObjective::init(ros::NodeHandle& nh,
+                                     const KDL::Chain& chain,
+                                     const KDL::JntArray& upper_pos_limits,
+                                     const KDL::JntArray& lower_pos_limits)
+  {
+    NullSpaceObjective::init(nh, chain, upper_pos_limits, lower_pos_limits);
+
+    m_jjt_inv_j.setZero(6, chain.getNrOfJoints());
+    return true;
+  }
+
+  void ManipulabilityObjective::computeMotion(const KDL::JntArray& positions,
+                                              const KDL::Jacobian& jacobian,
+                                              ctrl::VectorND& motion)
+  {
+    const auto& J = jacobian.data;
+    const int joints = J.cols();
+
+    m_jjt.noalias() = J * J.transpose();
+    m_jjt_ldlt.compute(m_jjt);
+    const double w = std::sqrt(std::max(m_jjt_ldlt.vectorD().prod(), 0.0));
+    m_jjt_inv_j = m_jjt_ldlt.solve(J);
+
+    // The trace sums column k of (J J^T)^{-1} J against column k of dJ/dq_i.
+    for (int i = 0; i < joints; ++i)
+    {
+      const Eigen::Vector3d w_i = J.col(i).tail<3>();
+      double trace = 0.0;
+      for (int k = 0; k < joints; ++k)
+      {
+        const Eigen::Vector3d w_k = J.col(k).tail<3>();
+        if (i <= k)
+        {
+          trace += m_jjt_inv_j.col(k).head<3>().dot(w_i.cross(J.col(k).head<3>()));
+          trace += m_jjt_inv_j.col(k).tail<3>().dot(w_i.cross(w_k));
+        }
+        else
+        {
+          trace += m_jjt_inv_j.col(k).head<3>().dot(w_k.cross(J.col(i).head<3>()));
+        }
+      }
+      motion[i] = m_gain * w * trace;
+    }
+  }
+
+} // namespace
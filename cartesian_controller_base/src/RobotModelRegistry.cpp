@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    RobotModelRegistry.cpp
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+// this package
+#include <cartesian_controller_base/RobotModelRegistry.h>
+
+// other
+#include <cmath>
+#include <functional>
+#include <kdl_parser/kdl_parser.hpp>
+#include <ros/param.h>
+#include <urdf_model/joint.h>
+
+namespace cartesian_controller_base{
+
+  bool RobotModel::init(const std::string& robot_description)
+  {
+    if (!m_model.initString(robot_description))
+    {
+      ROS_ERROR("Failed to parse urdf model from 'robot_description'");
+      return false;
+    }
+    if (!kdl_parser::treeFromUrdfModel(m_model, m_tree))
+    {
+      ROS_ERROR("Failed to parse KDL tree from urdf model");
+      return false;
+    }
+    return true;
+  }
+
+  bool RobotModel::getChain(const std::string& root, const std::string& tip, KDL::Chain& chain) const
+  {
+    return m_tree.getChain(root, tip, chain);
+  }
+
+  bool RobotModel::getJointLimits(const std::vector<std::string>& joints,
+                                  KDL::JntArray& upper_pos_limits,
+                                  KDL::JntArray& lower_pos_limits) const
+  {
+    upper_pos_limits.resize(joints.size());
+    lower_pos_limits.resize(joints.size());
+    for (size_t i = 0; i < joints.size(); ++i)
+    {
+      urdf::JointConstSharedPtr joint = m_model.getJoint(joints[i]);
+      if (!joint)
+      {
+        ROS_ERROR_STREAM("Joint " << joints[i] << " does not appear in robot_description");
+        return false;
+      }
+      if (joint->type == urdf::Joint::CONTINUOUS)
+      {
+        upper_pos_limits(i) = std::nan("0");
+        lower_pos_limits(i) = std::nan("0");
+      }
+      else if (joint->limits)
+      {
+        upper_pos_limits(i) = joint->limits->upper;
+        lower_pos_limits(i) = joint->limits->lower;
+      }
+      else  // Non-existent urdf limits are zero initialized
+      {
+        upper_pos_limits(i) = 0.0;
+        lower_pos_limits(i) = 0.0;
+      }
+    }
+    return true;
+  }
+
+  std::mutex                                        RobotModelRegistry::m_mutex;
+  std::multimap<size_t, RobotModelRegistry::Entry>  RobotModelRegistry::m_models;
+
+  std::shared_ptr<const RobotModel> RobotModelRegistry::get(const std::string& robot_description)
+  {
+    const size_t hash = std::hash<std::string>()(robot_description);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto range = m_models.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+      if (it->second.description == robot_description)
+      {
+        return it->second.model;
+      }
+    }
+
+    std::shared_ptr<RobotModel> model = std::make_shared<RobotModel>();
+    if (!model->init(robot_description))
+    {
+      return nullptr;
+    }
+
+    // Forget about models that nobody uses anymore, e.g. after the robot
+    // description changed.
+    for (auto it = m_models.begin(); it != m_models.end();)
+    {
+      it = it->second.model.use_count() == 1 ? m_models.erase(it) : std::next(it);
+    }
+
+    m_models.emplace(hash, Entry{robot_description, model});
+    return model;
+  }
+
+  std::shared_ptr<const RobotModel> RobotModelRegistry::load(const ros::NodeHandle& nh)
+  {
+    std::string robot_description;
+    if (!ros::param::search("robot_description", robot_description))
+    {
+      ROS_ERROR_STREAM("Searched enclosing namespaces for robot_description but nothing found");
+      return nullptr;
+    }
+    if (!nh.getParam(robot_description, robot_description))
+    {
+      ROS_ERROR_STREAM("Failed to load " << robot_description << " from parameter server");
+      return nullptr;
+    }
+    return get(robot_description);
+  }
+
+} // namespace
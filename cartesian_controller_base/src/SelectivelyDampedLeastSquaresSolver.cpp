@@ -71,51 +71,27 @@ namespace cartesian_controller_base{
 
   SelectivelyDampedLeastSquaresSolver::~SelectivelyDampedLeastSquaresSolver(){}
 
-  trajectory_msgs::JointTrajectoryPoint SelectivelyDampedLeastSquaresSolver::getJointControlCmds(
+  void SelectivelyDampedLeastSquaresSolver::getJointControlCmds(
         ros::Duration period,
-        const ctrl::Vector6D& net_force)
+        const ctrl::Vector6D& net_force,
+        KDL::JntArrayVel& control_cmd)
   {
     // Compute joint Jacobian
-    m_jnt_jacobian_solver->JntToJac(m_current_positions,m_jnt_jacobian);
+    m_kinematics.update(m_current_positions);
 
-    Eigen::JacobiSVD<Eigen::Matrix<double, 6, Eigen::Dynamic> > JSVD(
-      m_jnt_jacobian.data, Eigen::ComputeFullU | Eigen::ComputeFullV);
-    Eigen::Matrix<double, 6, 6> U = JSVD.matrixU();
-    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> V = JSVD.matrixV();
-    Eigen::Matrix<double, Eigen::Dynamic, 1> s = JSVD.singularValues();
-
-    // Default recommendation by Buss and Kim.
-    const double gamma_max = 3.141592653 / 4;
-
-    Eigen::Matrix<double, Eigen::Dynamic, 1> sum_phi =
-      Eigen::Matrix<double, Eigen::Dynamic, 1>::Zero(m_number_joints);
-
-    // Compute each joint velocity with the SDLS method.  This implements the
-    // algorithm as described in the paper (but for only one end-effector).
-    // Also see Buss' own implementation:
-    // https://www.math.ucsd.edu/~sbuss/ResearchWeb/ikmethods/index.html
-
-    for (int i = 0; i < m_number_joints; ++i)
+    switch (m_number_joints)
     {
-      double alpha = U.col(i).transpose() * net_force;
-
-      double N = U.col(i).head(3).norm();
-      double M = 0;
-      for (int j = 0; j < m_number_joints; ++j)
-      {
-        double rho = m_jnt_jacobian.data.col(j).head(3).norm();
-        M += std::abs(V.col(i)[j]) * rho;
-      }
-      M *= 1.0 / s[i];
-
-      double gamma = std::min(1.0, N / M) * gamma_max;
-
-      Eigen::Matrix<double, Eigen::Dynamic, 1> phi = clampMaxAbs(1.0 / s[i] * alpha * V.col(i), gamma);
-      sum_phi += phi;
+      case 6:
+        computeJointVelocities(net_force, m_workspace_6);
+        break;
+      case 7:
+        computeJointVelocities(net_force, m_workspace_7);
+        break;
+      default:
+        computeJointVelocities(net_force, m_workspace);
+        break;
     }
 
-    m_current_velocities.data = clampMaxAbs(sum_phi, gamma_max);
-
     // Integrate once, starting with zero motion
     m_current_positions.data = m_last_positions.data + 0.5 * m_current_velocities.data * period.toSec();
 
@@ -123,22 +99,11 @@ namespace cartesian_controller_base{
     applyJointLimits();
 
     // Apply results
-    trajectory_msgs::JointTrajectoryPoint control_cmd;
-    for (int i = 0; i < m_number_joints; ++i)
-    {
-      control_cmd.positions.push_back(m_current_positions(i));
-      control_cmd.velocities.push_back(m_current_velocities(i));
-
-      // Accelerations should be left empty. Those values will be interpreted
-      // by most hardware joint drivers as max. tolerated values. As a
-      // consequence, the robot will move very slowly.
-    }
-    control_cmd.time_from_start = period; // valid for this duration
+    control_cmd.q = m_current_positions;
+    control_cmd.qdot = m_current_velocities;
 
     // Update for the next cycle
     m_last_positions = m_current_positions;
-
-    return control_cmd;
   }
 
   bool SelectivelyDampedLeastSquaresSolver::init(ros::NodeHandle& nh,
@@ -148,23 +113,126 @@ namespace cartesian_controller_base{
   {
     IKSolver::init(nh, chain, upper_pos_limits, lower_pos_limits);
 
-    m_jnt_jacobian_solver.reset(new KDL::ChainJntToJacSolver(m_chain));
-    m_jnt_jacobian.resize(m_number_joints);
+    // Only the dynamic workspace needs memory.  The fixed-size ones are used
+    // for six and seven joints.
+    switch (m_number_joints)
+    {
+      case 6:
+      case 7:
+        break;
+      default:
+        m_workspace.resize(m_number_joints);
+        break;
+    }
 
     return true;
   }
 
-  Eigen::Matrix<double, Eigen::Dynamic, 1> SelectivelyDampedLeastSquaresSolver::clampMaxAbs(
-    const Eigen::Matrix<double, Eigen::Dynamic, 1>& w, double d)
+  template <int Joints>
+  void SelectivelyDampedLeastSquaresSolver::computeJointVelocities(
+      const ctrl::Vector6D& net_force, Workspace<Joints>& workspace)
   {
-    if (w.cwiseAbs().maxCoeff() <= d)
+    workspace.jacobian = m_kinematics.getJacobian().data;
+    if (updateSaturatedJoints(net_force))
     {
-      return w;
+      deactivateSaturatedJoints(workspace.jacobian);
     }
-    else
+    solveSelectivelyDamped(net_force, workspace);
+  }
+
+  template <int Joints>
+  void SelectivelyDampedLeastSquaresSolver::solveSelectivelyDamped(
+      const ctrl::Vector6D& net_force, Workspace<Joints>& workspace)
+  {
+    // Left singular vectors U and squared singular values of J
+    workspace.eigen_solver.compute(workspace.jacobian * workspace.jacobian.transpose());
+    const ctrl::Matrix6D& U = workspace.eigen_solver.eigenvectors();
+    const ctrl::Vector6D& s_squared = workspace.eigen_solver.eigenvalues();  // ascending
+
+    // Unnormalized right singular vectors, V_i * s_i
+    workspace.jacobian_transpose_u.noalias() = workspace.jacobian.transpose() * U;
+
+    // Translational length of each Jacobian column
+    for (int j = 0; j < m_number_joints; ++j)
     {
-      return d * w / w.cwiseAbs().maxCoeff();
+      workspace.rho[j] = workspace.jacobian.col(j).template head<3>().norm();
+    }
+
+    // Default recommendation by Buss and Kim.
+    const double gamma_max = 3.141592653 / 4;
+
+    // The eigen decomposition of J J^T works on squared singular values, so
+    // these are only accurate down to about sqrt(epsilon) relative to the
+    // largest one.  Smaller singular values are treated as zero.  Their
+    // contribution would be damped close to zero anyway.
+    const double s_squared_min = s_squared[5] * 1e-12;
+
+    workspace.sum_phi.setZero();
+
+    // Compute each joint velocity with the SDLS method.  This implements the
+    // algorithm as described in the paper (but for only one end-effector).
+    // Also see Buss' own implementation:
+    // https://www.math.ucsd.edu/~sbuss/ResearchWeb/ikmethods/index.html
+    //
+    // There are min(6, joints) non-zero singular values.
+    for (int i = 0; i < 6; ++i)
+    {
+      if (s_squared[i] <= s_squared_min)
+      {
+        continue;
+      }
+      auto scaled_v = workspace.jacobian_transpose_u.col(i);  // s_i * V_i
+
+      double alpha = U.col(i).transpose() * net_force;
+
+      double N = U.col(i).head(3).norm();
+      double M = scaled_v.cwiseAbs().dot(workspace.rho) / s_squared[i];
+
+      double gamma = std::min(1.0, N / M) * gamma_max;
+
+      workspace.phi.noalias() = alpha / s_squared[i] * scaled_v;
+      clampMaxAbs(workspace.phi, gamma);
+      workspace.sum_phi += workspace.phi;
+    }
+
+    clampMaxAbs(workspace.sum_phi, gamma_max);
+    m_current_velocities.data = workspace.sum_phi;
+
+    // Project the secondary objective into the null space of J.  This
+    // removes its components along the right singular vectors that we
+    // already have, i.e. \f$ \dot{q}_0 - \sum_i V_i V_i^T \dot{q}_0 \f$.
+    if (beginNullSpaceMotion())
+    {
+      m_current_velocities.data += m_null_space_motion;
+      for (int i = 0; i < 6; ++i)
+      {
+        if (s_squared[i] <= s_squared_min)
+        {
+          continue;
+        }
+        auto scaled_v = workspace.jacobian_transpose_u.col(i);  // s_i * V_i
+        m_current_velocities.data -= scaled_v.dot(m_null_space_motion) / s_squared[i] * scaled_v;
+      }
+      endNullSpaceMotion();
     }
   }
 
+  template <class Vector>
+  void SelectivelyDampedLeastSquaresSolver::clampMaxAbs(Eigen::MatrixBase<Vector>& w, double d)
+  {
+    const double max = w.cwiseAbs().maxCoeff();
+    if (max > d)
+    {
+      w *= d / max;
+    }
+  }
+
+  // For derived solvers
+  template void SelectivelyDampedLeastSquaresSolver::solveSelectivelyDamped<6>(
+      const ctrl::Vector6D&, Workspace<6>&);
+  template void SelectivelyDampedLeastSquaresSolver::solveSelectivelyDamped<7>(
+      const ctrl::Vector6D&, Workspace<7>&);
+  template void SelectivelyDampedLeastSquaresSolver::solveSelectivelyDamped<Eigen::Dynamic>(
+      const ctrl::Vector6D&, Workspace<Eigen::Dynamic>&);
+
 } // namespace
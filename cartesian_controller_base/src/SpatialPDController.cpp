@@ -41,44 +41,102 @@
 #include <cartesian_controller_base/SpatialPDController.h>
 
 // Other
+#include <algorithm>
+#include <functional>
 #include <string>
 
 namespace cartesian_controller_base
 {
 
 SpatialPDController::SpatialPDController()
+  : m_vectorized(true), m_derivative_filter(0.0),
+    m_last_error(ctrl::Vector6D::Zero()), m_error_derivative(ctrl::Vector6D::Zero())
 {
 }
 
 ctrl::Vector6D SpatialPDController::operator()(const ctrl::Vector6D& error, const ros::Duration& period)
 {
-  // Perform pd control separately on each Cartesian dimension
-  for (int i = 0; i < 6; ++i) // 3 transition, 3 rotation
+  if (!m_vectorized)
   {
-    m_cmd(i) = m_pd_controllers[i](error[i],period);
+    // Perform pd control separately on each Cartesian dimension
+    for (int i = 0; i < 6; ++i) // 3 transition, 3 rotation
+    {
+      m_cmd(i) = m_pd_controllers[i](error[i],period);
+    }
+    return m_cmd;
   }
+
+  if (period == ros::Duration(0.0))
+  {
+    return ctrl::Vector6D::Zero();
+  }
+
+  // First order low-pass on the derivative. Without filter, alpha is one
+  // and this is the plain difference quotient.
+  const double dt = period.toSec();
+  const double alpha = dt / (m_derivative_filter + dt);
+  const Gains& gains = *m_gains.readFromRT();
+
+  m_error_derivative += alpha * ((error - m_last_error) * (1.0 / dt) - m_error_derivative);
+  m_cmd = gains.p.cwiseProduct(error) + gains.d.cwiseProduct(m_error_derivative);
+
+  m_last_error = error;
   return m_cmd;
 }
 
 bool SpatialPDController::init(ros::NodeHandle& nh)
 {
-  // Initialize pd controllers for each Cartesian dimension
-  for (int i = 0; i < 6; ++i) // 3 transition, 3 rotation
-  {
-    m_pd_controllers.push_back(PDController());
-  }
-
   // Load default controller gains
   std::string solver_config = nh.getNamespace() + "/pd_gains";
+  const std::vector<std::string> axes = {
+    "/trans_x", "/trans_y", "/trans_z", "/rot_x", "/rot_y", "/rot_z"};
 
-  m_pd_controllers[0].init(solver_config + "/trans_x");
-  m_pd_controllers[1].init(solver_config + "/trans_y");
-  m_pd_controllers[2].init(solver_config + "/trans_z");
-  m_pd_controllers[3].init(solver_config + "/rot_x");
-  m_pd_controllers[4].init(solver_config + "/rot_y");
-  m_pd_controllers[5].init(solver_config + "/rot_z");
+  nh.getParam("pd_gains/vectorized", m_vectorized);
+  nh.getParam("pd_gains/derivative_filter", m_derivative_filter);
+  m_derivative_filter = std::max(m_derivative_filter, 0.0);
+
+  if (!m_vectorized)
+  {
+    if (m_derivative_filter > 0.0)
+    {
+      ROS_WARN("The derivative filter is only available for vectorized pd_gains");
+    }
+
+    // Initialize pd controllers for each Cartesian dimension
+    for (int i = 0; i < 6; ++i) // 3 transition, 3 rotation
+    {
+      m_pd_controllers.push_back(PDController());
+    }
+    for (int i = 0; i < 6; ++i)
+    {
+      m_pd_controllers[i].init(solver_config + axes[i]);
+    }
+    return true;
+  }
+
+  // Keep the per-axis tuning interface.  Each axis updates its entries in
+  // the common gain block.
+  for (int i = 0; i < 6; ++i)
+  {
+    m_dyn_conf_servers.push_back(
+        std::make_shared<dynamic_reconfigure::Server<PDGainsConfig> >(
+          ros::NodeHandle(solver_config + axes[i])));
+    m_dyn_conf_servers.back()->setCallback(std::bind(
+          &SpatialPDController::dynamicReconfigureCallback, this,
+          std::placeholders::_1, std::placeholders::_2, i));
+  }
 
   return true;
 }
 
+void SpatialPDController::dynamicReconfigureCallback(PDGainsConfig& config, uint32_t level, int axis)
+{
+  // The servers may call back from different threads, but the buffer
+  // supports only one writer.
+  std::lock_guard<std::mutex> lock(m_gains_mutex);
+  m_gains_nonrt.p[axis] = config.p;
+  m_gains_nonrt.d[axis] = config.d;
+  m_gains.writeFromNonRT(m_gains_nonrt);
+}
+
 } // namespace
@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    StateStream.cpp
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+// this package
+#include <cartesian_controller_base/StateStream.h>
+
+// ROS
+#include <ros/console.h>
+
+// other
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace cartesian_controller_base{
+
+  StateStream::StateStream()
+    : m_size(0), m_header(nullptr), m_records(nullptr), m_written(0)
+  {
+  }
+
+  StateStream::~StateStream()
+  {
+    if (m_header)
+    {
+      munmap(m_header, m_size);
+      shm_unlink(m_name.c_str());
+    }
+  }
+
+  bool StateStream::init(const std::string& name, size_t capacity)
+  {
+    if (m_header || capacity == 0)
+    {
+      return false;
+    }
+
+    const size_t size = sizeof(Header) + capacity * sizeof(Record);
+    const int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0644);
+    if (fd < 0)
+    {
+      ROS_ERROR_STREAM("StateStream: Failed to open shared memory " << name << ": " << std::strerror(errno));
+      return false;
+    }
+    if (ftruncate(fd, size) != 0)
+    {
+      ROS_ERROR_STREAM("StateStream: Failed to resize shared memory " << name << ": " << std::strerror(errno));
+      close(fd);
+      shm_unlink(name.c_str());
+      return false;
+    }
+    void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED)
+    {
+      ROS_ERROR_STREAM("StateStream: Failed to map shared memory " << name << ": " << std::strerror(errno));
+      shm_unlink(name.c_str());
+      return false;
+    }
+
+    // Touch all pages now, so that the realtime loop doesn't page fault.
+    std::memset(memory, 0, size);
+
+    m_name = name;
+    m_size = size;
+    m_header = static_cast<Header*>(memory);
+    m_records = reinterpret_cast<Record*>(m_header + 1);
+    m_written = 0;
+
+    m_header->version = VERSION;
+    m_header->capacity = capacity;
+    m_header->record_size = sizeof(Record);
+    m_header->magic = MAGIC;  // Readers check this last
+    m_header->written.store(0, std::memory_order_release);
+    return true;
+  }
+
+  StateStream::Record& StateStream::beginWrite()
+  {
+    Record& record = m_records[m_written % m_header->capacity];
+    record.sequence.store(2 * m_written + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    return record;
+  }
+
+  void StateStream::commit()
+  {
+    Record& record = m_records[m_written % m_header->capacity];
+    ++m_written;
+    record.sequence.store(2 * m_written, std::memory_order_release);
+    m_header->written.store(m_written, std::memory_order_release);
+  }
+
+} // namespace
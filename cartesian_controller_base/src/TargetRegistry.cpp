@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    TargetRegistry.cpp
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+// this package
+#include <cartesian_controller_base/TargetRegistry.h>
+
+// other
+#include <ros/console.h>
+
+namespace cartesian_controller_base{
+
+  std::mutex                                    TargetRegistry::m_mutex;
+  std::map<std::string, TargetRegistry::Entry>  TargetRegistry::m_channels;
+
+  std::shared_ptr<TargetChannel> TargetRegistry::getReader(const std::string& topic, const std::string& frame_id)
+  {
+    return get(topic, frame_id, true);
+  }
+
+  std::shared_ptr<TargetChannel> TargetRegistry::getWriter(const std::string& topic, const std::string& frame_id)
+  {
+    return get(topic, frame_id, false);
+  }
+
+  std::shared_ptr<TargetChannel> TargetRegistry::get(const std::string& topic,
+                                                     const std::string& frame_id,
+                                                     bool reader)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry& entry = m_channels[topic];
+
+    // Start over once nobody uses the channel anymore, e.g. after both
+    // controllers got unloaded.
+    if (entry.reader.expired() && entry.writer.expired())
+    {
+      entry.frame_id = frame_id;
+      entry.channel = std::make_shared<TargetChannel>();
+    }
+    else if (entry.frame_id != frame_id)
+    {
+      ROS_ERROR_STREAM("Targets on " << topic << " are expressed in "
+          << entry.frame_id << " but " << frame_id << " was requested");
+      return nullptr;
+    }
+
+    // The buffer supports only one thread on each side
+    std::weak_ptr<TargetChannel>& side = reader ? entry.reader : entry.writer;
+    if (!side.expired())
+    {
+      ROS_ERROR_STREAM("Targets on " << topic << " already have a "
+          << (reader ? "reader" : "writer") << " in this process");
+      return nullptr;
+    }
+
+    // A handle of its own, which keeps the channel alive
+    std::shared_ptr<TargetChannel> channel = entry.channel;
+    std::shared_ptr<TargetChannel> handle(channel.get(), [channel](TargetChannel*){});
+    side = handle;
+    return handle;
+  }
+
+} // namespace
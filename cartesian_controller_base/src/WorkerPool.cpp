@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    WorkerPool.cpp
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+// this package
+#include <cartesian_controller_base/WorkerPool.h>
+
+// ROS
+#include <ros/console.h>
+
+// other
+#include <cerrno>
+#include <pthread.h>
+#include <sched.h>
+
+namespace cartesian_controller_base{
+
+  bool configureWorkerThread(std::thread& thread, const std::string& name, int cpu, int priority)
+  {
+    bool success = true;
+    pthread_t handle = thread.native_handle();
+
+    if (cpu >= 0)
+    {
+      cpu_set_t cpu_set;
+      CPU_ZERO(&cpu_set);
+      CPU_SET(cpu, &cpu_set);
+      if (pthread_setaffinity_np(handle, sizeof(cpu_set), &cpu_set) != 0)
+      {
+        ROS_ERROR_STREAM("Failed to pin " << name << " to CPU " << cpu);
+        success = false;
+      }
+    }
+
+    if (priority > 0)
+    {
+      sched_param param;
+      param.sched_priority = priority;
+      if (pthread_setschedparam(handle, SCHED_FIFO, &param) != 0)
+      {
+        ROS_ERROR_STREAM("Failed to set realtime priority " << priority
+                         << " for " << name << ". Missing permissions?");
+        success = false;
+      }
+    }
+    return success;
+  }
+
+  WorkerPool::WorkerPool()
+    : m_pending(0), m_running(false)
+  {
+  }
+
+  WorkerPool::~WorkerPool()
+  {
+    stop();
+  }
+
+  bool WorkerPool::init(const std::vector<std::function<void()> >& tasks,
+                        const std::vector<int>& cpus,
+                        int priority)
+  {
+    stop();
+    m_tasks = tasks;
+    if (m_tasks.size() < 2)
+    {
+      return true;  // Nothing to parallelize
+    }
+
+    const int workers = m_tasks.size() - 1;
+    m_start.reset(new sem_t[workers]);
+    for (int i = 0; i < workers; ++i)
+    {
+      sem_init(&m_start[i], 0, 0);
+    }
+
+    bool success = true;
+    m_running = true;
+    for (int i = 0; i < workers; ++i)
+    {
+      m_workers.emplace_back(&WorkerPool::work, this, i + 1);
+      const int cpu = i < static_cast<int>(cpus.size()) ? cpus[i] : -1;
+      if (!configureWorkerThread(m_workers.back(), "worker " + std::to_string(i), cpu, priority))
+      {
+        success = false;
+      }
+    }
+    return success;
+  }
+
+  void WorkerPool::run()
+  {
+    if (m_workers.empty())
+    {
+      for (auto& task : m_tasks)
+      {
+        task();
+      }
+      return;
+    }
+
+    m_pending.store(m_workers.size(), std::memory_order_relaxed);
+    for (size_t i = 0; i < m_workers.size(); ++i)
+    {
+      sem_post(&m_start[i]);
+    }
+
+    m_tasks[0]();
+
+    // Barrier. The workers are about as fast as we are, so spinning is
+    // cheaper than going to sleep.
+    while (m_pending.load(std::memory_order_acquire) > 0)
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  void WorkerPool::work(int task)
+  {
+    sem_t& start = m_start[task - 1];
+    while (true)
+    {
+      while (sem_wait(&start) != 0 && errno == EINTR)
+      {
+      }
+      if (!m_running)
+      {
+        return;
+      }
+      m_tasks[task]();
+      m_pending.fetch_sub(1, std::memory_order_release);
+    }
+  }
+
+  void WorkerPool::stop()
+  {
+    if (m_workers.empty())
+    {
+      return;
+    }
+    m_running = false;
+    for (size_t i = 0; i < m_workers.size(); ++i)
+    {
+      sem_post(&m_start[i]);
+    }
+    for (auto& worker : m_workers)
+    {
+      worker.join();
+    }
+    for (size_t i = 0; i < m_workers.size(); ++i)
+    {
+      sem_destroy(&m_start[i]);
+    }
+    m_workers.clear();
+    m_start.reset();
+  }
+
+} // namespace
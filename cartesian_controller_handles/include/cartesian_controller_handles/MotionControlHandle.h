@@ -40,17 +40,23 @@
 #ifndef MOTION_CONTROL_HANDLE_H_INCLUDED
 #define MOTION_CONTROL_HANDLE_H_INCLUDED
 
+// Project
+#include <cartesian_controller_base/TripleBuffer.h>
+
 // ROS
 #include <ros/ros.h>
 #include <interactive_markers/interactive_marker_server.h>
 #include <geometry_msgs/PoseStamped.h>
+#include <realtime_tools/realtime_publisher.h>
 
 // ros_controls
 #include <controller_interface/controller.h>
 #include <hardware_interface/joint_state_interface.h>
 
 // Other
+#include <atomic>
 #include <memory>
+#include <thread>
 
 // KDL
 #include <kdl/chain.hpp>
@@ -70,6 +76,9 @@ namespace cartesian_controller_handles
  * controllers, such as the \ref CartesianMotionController or the \ref
  * CartesianComplianceController.
  *
+ * The interactive marker server runs in its own thread, so that the
+ * realtime loop only publishes the pose.
+ *
  * @tparam HardwareInterface Currently only JointStateInterface is supported
  */
 template <class HardwareInterface>
@@ -88,10 +97,21 @@ class MotionControlHandle : public controller_interface::Controller<HardwareInte
     /**
      * @brief Publish pose of the control handle as PoseStamped
      *
+     * Realtime safe.
      */
     void update(const ros::Time& time, const ros::Duration& period);
 
   private:
+    /**
+     * @brief Apply marker changes to the interactive marker server
+     *
+     * Runs in \ref m_marker_thread at the configured rate and only
+     * talks to the server if something changed.
+     *
+     * @param rate The update rate in Hz
+     */
+    void updateMarkers(double rate);
+
     /**
      * @brief Move visual marker in RViz according to user interaction
      *
@@ -159,8 +179,9 @@ class MotionControlHandle : public controller_interface::Controller<HardwareInte
     std::shared_ptr<
       KDL::ChainFkSolverPos_recursive>  m_fk_solver;
 
-    geometry_msgs::PoseStamped  m_current_pose;
-    ros::Publisher  m_pose_publisher;
+    //! Marker poses from RViz for the realtime loop
+    cartesian_controller_base::TripleBuffer<geometry_msgs::Pose> m_current_pose;
+    realtime_tools::RealtimePublisherSharedPtr<geometry_msgs::PoseStamped> m_pose_publisher;
 
     // Interactive marker
     std::shared_ptr<
@@ -168,6 +189,12 @@ class MotionControlHandle : public controller_interface::Controller<HardwareInte
 
     visualization_msgs::InteractiveMarker           m_marker; //!< Controller handle for RViz
 
+    //! Marker resets from the realtime loop, e.g. on starting()
+    cartesian_controller_base::TripleBuffer<geometry_msgs::Pose> m_marker_reset;
+    std::atomic<bool>                               m_marker_changed;
+    std::atomic<bool>                               m_marker_running;
+    std::thread                                     m_marker_thread;
+
 };
 
 } // cartesian_controller_handles
@@ -39,13 +39,10 @@
 
 // Project
 #include <cartesian_controller_handles/MotionControlHandle.h>
+#include <cartesian_controller_base/RobotModelRegistry.h>
 
-// KDL
-#include <kdl/tree.hpp>
-#include <kdl_parser/kdl_parser.hpp>
-
-// URDF
-#include <urdf/model.h>
+// Other
+#include <chrono>
 
 
 namespace cartesian_controller_handles
@@ -54,6 +51,7 @@ namespace cartesian_controller_handles
 template <class HardwareInterface>
 MotionControlHandle<HardwareInterface>::
 MotionControlHandle()
+  : m_marker_changed(false), m_marker_running(false)
 {
 }
 
@@ -61,15 +59,21 @@ template <class HardwareInterface>
 MotionControlHandle<HardwareInterface>::
 ~MotionControlHandle()
 {
+  m_marker_running = false;
+  if (m_marker_thread.joinable())
+  {
+    m_marker_thread.join();
+  }
 }
 
 template <class HardwareInterface>
 void MotionControlHandle<HardwareInterface>::
 starting(const ros::Time& time)
 {
-  m_current_pose = getEndEffectorPose();
-  m_server->setPose(m_marker.name,m_current_pose.pose);
-  m_server->applyChanges();
+  // Start where the robot is.  The marker follows in its own thread.
+  const geometry_msgs::Pose pose = getEndEffectorPose().pose;
+  m_current_pose.initRT(pose);
+  m_marker_reset.writeFromNonRT(pose);
 }
 
 template <class HardwareInterface>
@@ -83,10 +87,32 @@ void MotionControlHandle<HardwareInterface>::
 update(const ros::Time& time, const ros::Duration& period)
 {
   // Publish marker pose
-  m_current_pose.header.stamp = time;
-  m_current_pose.header.frame_id = m_robot_base_link;
-  m_pose_publisher.publish(m_current_pose);
-  m_server->applyChanges();
+  if (m_pose_publisher->trylock())
+  {
+    m_pose_publisher->msg_.header.stamp = time;
+    m_pose_publisher->msg_.pose = *m_current_pose.readFromRT();
+    m_pose_publisher->unlockAndPublish();
+  }
+}
+
+template <class HardwareInterface>
+void MotionControlHandle<HardwareInterface>::
+updateMarkers(double rate)
+{
+  const std::chrono::duration<double> period(1.0 / rate);
+  while (m_marker_running)
+  {
+    if (m_marker_reset.hasNewData())
+    {
+      m_server->setPose(m_marker.name, *m_marker_reset.readFromRT());
+      m_marker_changed = true;
+    }
+    if (m_marker_changed.exchange(false))
+    {
+      m_server->applyChanges();
+    }
+    std::this_thread::sleep_for(period);
+  }
 }
 
 
@@ -94,19 +120,12 @@ template <class HardwareInterface>
 bool MotionControlHandle<HardwareInterface>::
 init(HardwareInterface* hw, ros::NodeHandle& nh)
 {
-  std::string robot_description;
-  urdf::Model robot_model;
-  KDL::Tree   robot_tree;
-
-  // Get configuration from parameter server
-  if (!ros::param::search("robot_description", robot_description))
+  // Get configuration from parameter server.  The parsed robot model is
+  // shared with the controllers.
+  std::shared_ptr<const cartesian_controller_base::RobotModel> robot_model =
+    cartesian_controller_base::RobotModelRegistry::load(nh);
+  if (!robot_model)
   {
-    ROS_ERROR_STREAM("Searched enclosing namespaces for robot_description but nothing found");
-    return false;
-  }
-  if (!nh.getParam(robot_description, robot_description))
-  {
-    ROS_ERROR_STREAM("Failed to load " << robot_description << " from parameter server");
     return false;
   }
   if (!nh.getParam("robot_base_link",m_robot_base_link))
@@ -130,20 +149,14 @@ init(HardwareInterface* hw, ros::NodeHandle& nh)
   }
 
   // Publishers
-  m_pose_publisher = nh.advertise<geometry_msgs::PoseStamped>(m_target_frame_topic,10);
+  m_pose_publisher = std::make_shared<realtime_tools::RealtimePublisher<geometry_msgs::PoseStamped> >(
+      nh, m_target_frame_topic, 10);
+  m_pose_publisher->lock();
+  m_pose_publisher->msg_.header.frame_id = m_robot_base_link;
+  m_pose_publisher->unlock();
 
   // Build a kinematic chain of the robot
-  if (!robot_model.initString(robot_description))
-  {
-    ROS_ERROR("Failed to parse urdf model from 'robot_description'");
-    return false;
-  }
-  if (!kdl_parser::treeFromUrdfModel(robot_model,robot_tree))
-  {
-    ROS_ERROR("Failed to parse KDL tree from urdf model");
-    return false;
-  }
-  if (!robot_tree.getChain(m_robot_base_link,m_end_effector_link,m_robot_chain))
+  if (!robot_model->getChain(m_robot_base_link,m_end_effector_link,m_robot_chain))
   {
     ROS_ERROR_STREAM("Failed to parse robot chain from urdf model.");
     return false;
@@ -164,7 +177,8 @@ init(HardwareInterface* hw, ros::NodeHandle& nh)
 
   // Initialize kinematics
   m_fk_solver.reset(new KDL::ChainFkSolverPos_recursive(m_robot_chain));
-  m_current_pose = getEndEffectorPose();
+  const geometry_msgs::Pose pose = getEndEffectorPose().pose;
+  m_current_pose.initRT(pose);
 
   // Configure the interactive marker for usage in RViz
   m_server.reset(new interactive_markers::InteractiveMarkerServer(
@@ -173,7 +187,7 @@ init(HardwareInterface* hw, ros::NodeHandle& nh)
   m_marker.header.stamp = ros::Time(0);   // makes frame_id const
   m_marker.scale = 0.1;
   m_marker.name = "motion_control_handle";
-  m_marker.pose = m_current_pose.pose;
+  m_marker.pose = pose;
   m_marker.description = "6D control of link: " + m_end_effector_link;
 
   prepareMarkerControls(m_marker);
@@ -196,6 +210,17 @@ init(HardwareInterface* hw, ros::NodeHandle& nh)
   // Activate configuration
   m_server->applyChanges();
 
+  // Talk to RViz outside the realtime loop
+  double marker_update_rate = 30.0;
+  nh.getParam("marker_update_rate", marker_update_rate);
+  if (marker_update_rate <= 0.0)
+  {
+    ROS_ERROR_STREAM(nh.getNamespace() << "/marker_update_rate must be positive");
+    return false;
+  }
+  m_marker_running = true;
+  m_marker_thread = std::thread(&MotionControlHandle::updateMarkers, this, marker_update_rate);
+
   return true;
 }
 
@@ -204,13 +229,12 @@ void MotionControlHandle<HardwareInterface>::
 updateMotionControlCallback(
     const visualization_msgs::InteractiveMarkerFeedbackConstPtr& feedback)
 {
-  // Move marker in RViz
+  // Move marker in RViz with the next marker update
   m_server->setPose(feedback->marker_name,feedback->pose);
-  m_server->applyChanges();
+  m_marker_changed = true;
 
   // Store for later broadcasting
-  m_current_pose.pose = feedback->pose;
-  m_current_pose.header.stamp = ros::Time::now();
+  m_current_pose.writeFromNonRT(feedback->pose);
 
 }
 
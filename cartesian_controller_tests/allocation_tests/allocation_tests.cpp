@@ -0,0 +1,380 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    allocation_tests.cpp
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+// this package
+#include "../benchmarks/benchmark_utility.h"
+
+// Project
+#include <cartesian_controller_base/AllocationHooks.h>
+
+// Other
+#include <cstdlib>
+#include <functional>
+#include <gtest/gtest.h>
+
+using namespace cartesian_controller_benchmarks;
+using cartesian_controller_base::AllocationTracker;
+using hardware_interface::PositionJointInterface;
+using hardware_interface::VelocityJointInterface;
+
+/**
+ * @brief Expect one allocation tracking section per update()
+ *
+ * The chains of the MultiChainMotionController track several sections each.
+ */
+template <class Controller>
+void expectSectionsPerUpdate(Controller& controller, unsigned int cycles)
+{
+  EXPECT_EQ(cycles, controller.getAllocationTracker()->getSections());
+}
+
+template <class HardwareInterface>
+void expectSectionsPerUpdate(MultiChainController<HardwareInterface>& controller, unsigned int cycles)
+{
+}
+
+/**
+ * @brief Run a controller into steady state and count the allocations of its update()
+ *
+ * The first cycles after starting are not counted.  Target changes and sensor
+ * samples come outside of update(), like the callbacks of a real controller.
+ * The allocations of the controller's worker threads count as well.
+ *
+ * @param joints The number of joints of the generic robot
+ * @param ik_solver The name of the IK solver plugin to use
+ * @param configure Optionally set further parameters in the controller's namespace before init()
+ * @param during Optionally change the controller before each update(), given the cycle
+ */
+template <class Controller, class HardwareInterface>
+void expectAllocationFreeUpdates(int joints, const std::string& ik_solver,
+                                 const std::function<void(ros::NodeHandle&)>& configure = nullptr,
+                                 const std::function<void(Controller&, int)>& during = nullptr)
+{
+  static int instance = 0;
+  const std::string ns = ros::this_node::getName() + "/controller_" + std::to_string(instance++);
+  setControllerParameters(ns, joints, ik_solver);
+  ros::NodeHandle nh(ns);
+  nh.setParam("track_allocations", true);
+  if (configure)
+  {
+    configure(nh);
+  }
+
+  // Stage timings get published once per second of wall time
+  bool real_time = false;
+  nh.getParam("solver/publish_stage_timings", real_time);
+
+  // Through initRequest() for the preview interface
+  MockHardware hw(joints);
+  ros::NodeHandle root_nh;
+  controller_interface::ControllerBase::ClaimedResources claimed_resources;
+  Controller controller;
+  ASSERT_TRUE(controller.initRequest(&hw, root_nh, nh, claimed_resources));
+  ASSERT_FALSE(controller.getAllocationTrackers().empty());
+
+  const ros::Duration period(0.002);
+  ros::Time time = ros::Time::now();
+  controller.starting(time);
+
+  double offset = 0.05;
+  int total = 0;
+  auto run = [&](int cycles)
+  {
+    for (int cycle = 0; cycle < cycles; ++cycle, ++total)
+    {
+      if (cycle % 100 == 0)
+      {
+        offset = -offset;
+        controller.setTargetOffset(offset, time);
+      }
+      controller.feedSensors(time, period);
+      if (during)
+      {
+        during(controller, total);
+      }
+      time += period;
+      controller.update(time, period);
+      hw.write<HardwareInterface>(period);
+      if (real_time)
+      {
+        ros::WallDuration(period.toSec()).sleep();
+      }
+    }
+  };
+
+  // Warm up, e.g. for lazy initialization in the first cycles
+  run(100);
+  controller.resetAllocationTrackers();
+
+  run(1000);
+  controller.stopping(time);  // Waits for the workers
+  expectSectionsPerUpdate(controller, 1000);
+  for (const AllocationTracker* tracker : controller.getAllocationTrackers())
+  {
+    EXPECT_LT(0u, tracker->getSections()) << tracker->report();
+    EXPECT_EQ(0u, tracker->getAllocations()) << tracker->report();
+  }
+}
+
+TEST(AllocationTests, hooksAreLinked)
+{
+  ASSERT_TRUE(AllocationTracker::isHooked());
+
+  AllocationTracker tracker;
+  {
+    AllocationTracker::Scope scope(&tracker);
+    void* volatile data = std::malloc(64);  // Not optimized away
+    std::free(data);
+  }
+  EXPECT_EQ(1u, tracker.getAllocations());
+  EXPECT_EQ(1u, tracker.getAllocatingSections());
+}
+
+TEST(AllocationTests, motionControllerPosition)
+{
+  expectAllocationFreeUpdates<MotionController<PositionJointInterface>, PositionJointInterface>(6, "forward_dynamics");
+  expectAllocationFreeUpdates<MotionController<PositionJointInterface>, PositionJointInterface>(7, "forward_dynamics");
+}
+
+TEST(AllocationTests, motionControllerVelocity)
+{
+  expectAllocationFreeUpdates<MotionController<VelocityJointInterface>, VelocityJointInterface>(6, "forward_dynamics");
+}
+
+TEST(AllocationTests, motionControllerSolvers)
+{
+  expectAllocationFreeUpdates<MotionController<PositionJointInterface>, PositionJointInterface>(7, "damped_least_squares");
+  expectAllocationFreeUpdates<MotionController<PositionJointInterface>, PositionJointInterface>(7, "selectively_damped_least_squares");
+  expectAllocationFreeUpdates<MotionController<PositionJointInterface>, PositionJointInterface>(7, "hybrid_damped_least_squares");
+}
+
+TEST(AllocationTests, forceController)
+{
+  expectAllocationFreeUpdates<ForceController<PositionJointInterface>, PositionJointInterface>(6, "forward_dynamics");
+  expectAllocationFreeUpdates<ForceController<VelocityJointInterface>, VelocityJointInterface>(6, "forward_dynamics");
+}
+
+TEST(AllocationTests, complianceController)
+{
+  expectAllocationFreeUpdates<ComplianceController<PositionJointInterface>, PositionJointInterface>(6, "forward_dynamics");
+  expectAllocationFreeUpdates<ComplianceController<VelocityJointInterface>, VelocityJointInterface>(7, "forward_dynamics");
+}
+
+/**
+ * @brief Optional features that run in update(), set through dynamic reconfigure
+ */
+void publishStateFeedback(ros::NodeHandle& nh)
+{
+  nh.setParam("solver/publish_state_feedback", true);
+}
+
+void publishCombinedStateFeedback(ros::NodeHandle& nh)
+{
+  nh.setParam("solver/publish_state_feedback", true);
+  nh.setParam("solver/combined_state_feedback", true);
+  nh.setParam("solver/state_feedback_decimation", 3);
+}
+
+void publishStageTimings(ros::NodeHandle& nh)
+{
+  nh.setParam("solver/publish_stage_timings", true);
+}
+
+void decimateSolver(ros::NodeHandle& nh)
+{
+  nh.setParam("solver/solver_decimation", 4);
+}
+
+void enableAllFeatures(ros::NodeHandle& nh)
+{
+  publishCombinedStateFeedback(nh);
+  publishStageTimings(nh);
+  decimateSolver(nh);
+}
+
+TEST(AllocationTests, stateFeedback)
+{
+  expectAllocationFreeUpdates<MotionController<PositionJointInterface>, PositionJointInterface>(6, "forward_dynamics", publishStateFeedback);
+  expectAllocationFreeUpdates<MotionController<PositionJointInterface>, PositionJointInterface>(6, "forward_dynamics", publishCombinedStateFeedback);
+}
+
+TEST(AllocationTests, stageTimings)
+{
+  expectAllocationFreeUpdates<MotionController<PositionJointInterface>, PositionJointInterface>(6, "forward_dynamics", publishStageTimings);
+  expectAllocationFreeUpdates<MotionController<PositionJointInterface>, PositionJointInterface>(7, "hybrid_damped_least_squares", publishStageTimings);
+}
+
+TEST(AllocationTests, solverDecimation)
+{
+  expectAllocationFreeUpdates<MotionController<PositionJointInterface>, PositionJointInterface>(6, "forward_dynamics", decimateSolver);
+  expectAllocationFreeUpdates<MotionController<VelocityJointInterface>, VelocityJointInterface>(6, "forward_dynamics", decimateSolver);
+}
+
+TEST(AllocationTests, allFeatures)
+{
+  expectAllocationFreeUpdates<MotionController<PositionJointInterface>, PositionJointInterface>(7, "forward_dynamics", enableAllFeatures);
+  expectAllocationFreeUpdates<ForceController<PositionJointInterface>, PositionJointInterface>(6, "forward_dynamics", enableAllFeatures);
+  expectAllocationFreeUpdates<ComplianceController<VelocityJointInterface>, VelocityJointInterface>(6, "forward_dynamics", enableAllFeatures);
+}
+
+/**
+ * @brief Features of the IK solvers, set on startup or through dynamic reconfigure
+ */
+void centerJoints(ros::NodeHandle& nh)
+{
+  nh.setParam("solver/null_space/objective", "joint_centering");
+  nh.setParam("solver/null_space/gain", 0.5);
+}
+
+void maximizeManipulability(ros::NodeHandle& nh)
+{
+  nh.setParam("solver/null_space/objective", "manipulability");
+  nh.setParam("solver/null_space/gain", 0.5);
+}
+
+void avoidLimits(ros::NodeHandle& nh)
+{
+  nh.setParam("solver/limit_aware", true);
+}
+
+TEST(AllocationTests, nullSpaceObjectives)
+{
+  expectAllocationFreeUpdates<MotionController<PositionJointInterface>, PositionJointInterface>(7, "forward_dynamics", centerJoints);
+  expectAllocationFreeUpdates<MotionController<PositionJointInterface>, PositionJointInterface>(7, "forward_dynamics", maximizeManipulability);
+  expectAllocationFreeUpdates<MotionController<PositionJointInterface>, PositionJointInterface>(7, "damped_least_squares", maximizeManipulability);
+}
+
+TEST(AllocationTests, limitAware)
+{
+  expectAllocationFreeUpdates<MotionController<PositionJointInterface>, PositionJointInterface>(6, "forward_dynamics", avoidLimits);
+  expectAllocationFreeUpdates<MotionController<PositionJointInterface>, PositionJointInterface>(7, "damped_least_squares", avoidLimits);
+}
+
+TEST(AllocationTests, asyncSolver)
+{
+  auto solveAsynchronously = [](ros::NodeHandle& nh)
+  {
+    nh.setParam("async_solver", true);
+  };
+  expectAllocationFreeUpdates<MotionController<PositionJointInterface>, PositionJointInterface>(6, "forward_dynamics", solveAsynchronously);
+  expectAllocationFreeUpdates<ComplianceController<VelocityJointInterface>, VelocityJointInterface>(7, "forward_dynamics", solveAsynchronously);
+}
+
+TEST(AllocationTests, targetInputs)
+{
+  typedef MotionController<PositionJointInterface> Controller;
+  auto streamPath = [](Controller& controller, int cycle)
+  {
+    controller.setTargetInput(TargetInput::PATH);
+  };
+  auto commandTwist = [](Controller& controller, int cycle)
+  {
+    controller.setTargetInput(TargetInput::TWIST);
+  };
+  expectAllocationFreeUpdates<Controller, PositionJointInterface>(6, "forward_dynamics", nullptr, streamPath);
+  expectAllocationFreeUpdates<Controller, PositionJointInterface>(6, "forward_dynamics", nullptr, commandTwist);
+}
+
+TEST(AllocationTests, solverSwitching)
+{
+  typedef MotionController<PositionJointInterface> Controller;
+  auto preloadSolvers = [](ros::NodeHandle& nh)
+  {
+    nh.setParam("ik_solvers", std::vector<std::string>{"forward_dynamics", "damped_least_squares"});
+  };
+  auto switchSolvers = [](Controller& controller, int cycle)
+  {
+    if (cycle % 50 == 0)
+    {
+      ASSERT_TRUE(controller.selectIKSolver(cycle % 100 ? "damped_least_squares" : "forward_dynamics"));
+    }
+  };
+  expectAllocationFreeUpdates<Controller, PositionJointInterface>(7, "forward_dynamics", preloadSolvers, switchSolvers);
+}
+
+TEST(AllocationTests, jointPreview)
+{
+  auto previewJoints = [](ros::NodeHandle& nh)
+  {
+    nh.setParam("preview_horizon", 5);
+  };
+  expectAllocationFreeUpdates<MotionController<PositionJointInterface>, PositionJointInterface>(6, "forward_dynamics", previewJoints);
+  expectAllocationFreeUpdates<ComplianceController<VelocityJointInterface>, VelocityJointInterface>(6, "forward_dynamics", previewJoints);
+}
+
+TEST(AllocationTests, multiChainMotionController)
+{
+  const int joints = 12;
+  auto splitChains = [](ros::NodeHandle& nh)
+  {
+    setChainParameters(nh.getNamespace(), joints, "forward_dynamics");
+    nh.setParam("first/track_allocations", true);
+    nh.setParam("second/track_allocations", true);
+  };
+  expectAllocationFreeUpdates<MultiChainController<PositionJointInterface>, PositionJointInterface>(joints, "forward_dynamics", splitChains);
+  expectAllocationFreeUpdates<MultiChainController<VelocityJointInterface>, VelocityJointInterface>(joints, "forward_dynamics", splitChains);
+}
+
+TEST(AllocationTests, forceSensorSamples)
+{
+  typedef ForceController<PositionJointInterface> Controller;
+  auto filterWrenches = [](ros::NodeHandle& nh)
+  {
+    nh.setParam("ft_sensor_filter", 1);  // Low-pass
+    nh.setParam("ft_sensor_filter_frequency", 50.0);
+    nh.setParam("ft_sensor_filter_q", 0.7071);
+    nh.setParam("ft_sensor_rate", 1000.0);
+  };
+  auto sampleTwicePerCycle = [](Controller& controller, int cycle)
+  {
+    controller.setSensorSamples(2);
+  };
+  expectAllocationFreeUpdates<Controller, PositionJointInterface>(6, "forward_dynamics", nullptr, sampleTwicePerCycle);
+  expectAllocationFreeUpdates<Controller, PositionJointInterface>(6, "forward_dynamics", filterWrenches, sampleTwicePerCycle);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  ros::init(argc, argv, "allocation_tests");
+  ros::NodeHandle nh;  // Keep ROS alive during the tests
+
+  const int result = RUN_ALL_TESTS();
+  ros::param::del(ros::this_node::getName());
+  return result;
+}
@@ -0,0 +1,550 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    benchmark_utility.h
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef BENCHMARK_UTILITY_H_INCLUDED
+#define BENCHMARK_UTILITY_H_INCLUDED
+
+// Project
+#include <cartesian_controller_base/AllocationTracker.h>
+#include <cartesian_controller_base/JointPreviewInterface.h>
+#include <cartesian_motion_controller/cartesian_motion_controller.h>
+#include <cartesian_motion_controller/multi_chain_motion_controller.h>
+#include <cartesian_force_controller/cartesian_force_controller.h>
+#include <cartesian_compliance_controller/cartesian_compliance_controller.h>
+
+// ROS
+#include <geometry_msgs/PoseStamped.h>
+#include <geometry_msgs/TwistStamped.h>
+#include <geometry_msgs/WrenchStamped.h>
+#include <nav_msgs/Path.h>
+#include <ros/ros.h>
+
+// ros_controls
+#include <hardware_interface/joint_command_interface.h>
+#include <hardware_interface/joint_state_interface.h>
+#include <hardware_interface/robot_hw.h>
+
+// Other
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace cartesian_controller_benchmarks
+{
+
+/**
+ * @brief Register the controller benchmarks with google benchmark
+ *
+ * These depend on the controller templates and are therefore registered at
+ * runtime, after ROS is initialized.
+ */
+void registerControllerBenchmarks();
+
+/**
+ * @brief Names of the movable joints of \ref robotDescription
+ */
+inline std::vector<std::string> jointNames(int joints)
+{
+  std::vector<std::string> names;
+  for (int i = 0; i < joints; ++i)
+  {
+    names.push_back("joint_" + std::to_string(i + 1));
+  }
+  return names;
+}
+
+/**
+ * @brief Generate the URDF of a generic serial manipulator
+ *
+ * The joint axes alternate between z and y, such that each chain of six or
+ * more joints can reach full 6D motion.  The chain goes from \a base_link to
+ * \a tool0.
+ *
+ * @param joints The number of revolute joints
+ *
+ * @return The URDF as string, ready to be put on the parameter server
+ */
+inline std::string robotDescription(int joints)
+{
+  const std::vector<std::string> names = jointNames(joints);
+  std::stringstream urdf;
+  urdf << "<?xml version=\"1.0\"?>\n"
+       << "<robot name=\"benchmark_robot_" << joints << "\">\n"
+       << "  <link name=\"base_link\"/>\n";
+
+  std::string parent = "base_link";
+  for (int i = 0; i < joints; ++i)
+  {
+    const std::string child = "link_" + std::to_string(i + 1);
+    urdf << "  <link name=\"" << child << "\"/>\n"
+         << "  <joint name=\"" << names[i] << "\" type=\"revolute\">\n"
+         << "    <parent link=\"" << parent << "\"/>\n"
+         << "    <child link=\"" << child << "\"/>\n"
+         << "    <origin xyz=\"0 0 " << (i == 0 ? 0.1 : 0.2) << "\" rpy=\"0 0 0\"/>\n"
+         << "    <axis xyz=\"0 " << (i % 2) << " " << ((i + 1) % 2) << "\"/>\n"
+         << "    <limit lower=\"-3.14\" upper=\"3.14\" effort=\"100\" velocity=\"3.0\"/>\n"
+         << "  </joint>\n";
+    parent = child;
+  }
+
+  urdf << "  <link name=\"tool0\"/>\n"
+       << "  <joint name=\"flange\" type=\"fixed\">\n"
+       << "    <parent link=\"" << parent << "\"/>\n"
+       << "    <child link=\"tool0\"/>\n"
+       << "    <origin xyz=\"0 0 0.1\" rpy=\"0 0 0\"/>\n"
+       << "  </joint>\n"
+       << "</robot>\n";
+  return urdf.str();
+}
+
+/**
+ * @brief A joint configuration that is away from singularities
+ */
+inline double startPosition(int joint)
+{
+  return (joint % 2 ? -0.5 : 0.5) + 0.1 * joint;
+}
+
+/**
+ * @brief A robot hardware that immediately follows its commands
+ *
+ * Offers both position and velocity interfaces for the joints of
+ * \ref robotDescription, and a preview interface for their upcoming states.
+ * Call \ref write after each controller update to feed the commands back into
+ * the joint state.
+ */
+class MockHardware : public hardware_interface::RobotHW
+{
+  public:
+    explicit MockHardware(int joints, size_t preview_horizon = 10)
+      : m_positions(joints), m_velocities(joints, 0.0), m_efforts(joints, 0.0),
+        m_position_cmds(joints), m_velocity_cmds(joints, 0.0),
+        m_preview_positions(joints * preview_horizon, 0.0),
+        m_preview_velocities(joints * preview_horizon, 0.0)
+    {
+      const std::vector<std::string> names = jointNames(joints);
+      for (int i = 0; i < joints; ++i)
+      {
+        m_positions[i] = startPosition(i);
+        m_position_cmds[i] = m_positions[i];
+
+        m_state_interface.registerHandle(hardware_interface::JointStateHandle(
+              names[i], &m_positions[i], &m_velocities[i], &m_efforts[i]));
+        m_position_interface.registerHandle(hardware_interface::JointHandle(
+              m_state_interface.getHandle(names[i]), &m_position_cmds[i]));
+        m_velocity_interface.registerHandle(hardware_interface::JointHandle(
+              m_state_interface.getHandle(names[i]), &m_velocity_cmds[i]));
+        m_preview_interface.registerHandle(cartesian_controller_base::JointPreviewHandle(
+              names[i],
+              &m_preview_positions[i * preview_horizon],
+              &m_preview_velocities[i * preview_horizon],
+              preview_horizon));
+      }
+      registerInterface(&m_state_interface);
+      registerInterface(&m_position_interface);
+      registerInterface(&m_velocity_interface);
+      registerInterface(&m_preview_interface);
+    }
+
+    //! Apply the last commands of the given interface to the joint state
+    template <class HardwareInterface>
+    void write(const ros::Duration& period);
+
+  private:
+    std::vector<double> m_positions;
+    std::vector<double> m_velocities;
+    std::vector<double> m_efforts;
+    std::vector<double> m_position_cmds;
+    std::vector<double> m_velocity_cmds;
+    std::vector<double> m_preview_positions;
+    std::vector<double> m_preview_velocities;
+
+    hardware_interface::JointStateInterface    m_state_interface;
+    hardware_interface::PositionJointInterface m_position_interface;
+    hardware_interface::VelocityJointInterface m_velocity_interface;
+    cartesian_controller_base::JointPreviewInterface m_preview_interface;
+};
+
+template <>
+inline void MockHardware::write<hardware_interface::PositionJointInterface>(const ros::Duration& period)
+{
+  for (size_t i = 0; i < m_positions.size(); ++i)
+  {
+    m_velocities[i] = (m_position_cmds[i] - m_positions[i]) / period.toSec();
+    m_positions[i] = m_position_cmds[i];
+  }
+}
+
+template <>
+inline void MockHardware::write<hardware_interface::VelocityJointInterface>(const ros::Duration& period)
+{
+  for (size_t i = 0; i < m_positions.size(); ++i)
+  {
+    m_velocities[i] = m_velocity_cmds[i];
+    m_positions[i] += m_velocity_cmds[i] * period.toSec();
+  }
+}
+
+/**
+ * @brief Put a complete controller configuration on the parameter server
+ *
+ * Controllers search \a robot_description from the node's private namespace
+ * upwards, so this puts one there and leaves a global one alone, e.g. of a
+ * real robot.  Call this right before initializing each controller.
+ *
+ * @param ns The controller's namespace, preferably in the node's private namespace
+ * @param joints The number of joints of the robot to control
+ * @param ik_solver The name of the IK solver plugin to use
+ */
+inline void setControllerParameters(const std::string& ns, int joints, const std::string& ik_solver)
+{
+  ros::param::set("~robot_description", robotDescription(joints));
+
+  ros::NodeHandle nh(ns);
+  nh.setParam("ik_solver", ik_solver);
+  nh.setParam("robot_base_link", "base_link");
+  nh.setParam("end_effector_link", "tool0");
+  nh.setParam("ft_sensor_ref_link", "tool0");
+  nh.setParam("compliance_ref_link", "tool0");
+  nh.setParam("joints", jointNames(joints));
+}
+
+/**
+ * @brief Put a MultiChainMotionController configuration on the parameter server
+ *
+ * Splits the robot of \ref robotDescription into two chains, \a first up to
+ * the middle link and \a second from there to the tool.
+ *
+ * @param ns The controller's namespace, preferably in the node's private namespace
+ * @param joints The number of joints of the robot to control
+ * @param ik_solver The name of the IK solver plugin for both chains
+ */
+inline void setChainParameters(const std::string& ns, int joints, const std::string& ik_solver)
+{
+  ros::param::set("~robot_description", robotDescription(joints));
+
+  const std::vector<std::string> names = jointNames(joints);
+  const std::string middle_link = "link_" + std::to_string(joints / 2);
+
+  ros::NodeHandle nh(ns);
+  nh.setParam("chains", std::vector<std::string>{"first", "second"});
+
+  ros::NodeHandle first(nh, "first");
+  first.setParam("ik_solver", ik_solver);
+  first.setParam("robot_base_link", "base_link");
+  first.setParam("end_effector_link", middle_link);
+  first.setParam("joints", std::vector<std::string>(names.begin(), names.begin() + joints / 2));
+
+  ros::NodeHandle second(nh, "second");
+  second.setParam("ik_solver", ik_solver);
+  second.setParam("robot_base_link", middle_link);
+  second.setParam("end_effector_link", "tool0");
+  second.setParam("joints", std::vector<std::string>(names.begin() + joints / 2, names.end()));
+}
+
+/**
+ * @brief A target pose at the given offset from a reference pose
+ */
+inline geometry_msgs::PoseStamped targetPose(
+    const KDL::Frame& reference, const std::string& base_link, double offset)
+{
+  geometry_msgs::PoseStamped target;
+  target.header.frame_id = base_link;
+  target.pose.position.x = reference.p.x() + offset;
+  target.pose.position.y = reference.p.y();
+  target.pose.position.z = reference.p.z() - offset;
+  reference.M.GetQuaternion(
+      target.pose.orientation.x,
+      target.pose.orientation.y,
+      target.pose.orientation.z,
+      target.pose.orientation.w);
+  return target;
+}
+
+/**
+ * @brief A streamed path from the opposite offset to the given one
+ *
+ * The path starts in the next control cycle and takes about 100 cycles of
+ * 2 ms, such that the stream runs dry before the next one.
+ */
+inline nav_msgs::Path targetPath(
+    const KDL::Frame& reference, const std::string& base_link, double offset, const ros::Time& time)
+{
+  const int samples = 10;
+  nav_msgs::Path path;
+  path.header.frame_id = base_link;
+  for (int i = 0; i < samples; ++i)
+  {
+    const double s = static_cast<double>(i) / (samples - 1);
+    path.poses.push_back(targetPose(reference, base_link, (2.0 * s - 1.0) * offset));
+    path.poses.back().header.stamp = time + ros::Duration(0.002 + 0.02 * i);
+  }
+  return path;
+}
+
+/**
+ * @brief A twist in the base link that moves towards the given offset
+ */
+inline geometry_msgs::TwistStamped targetTwist(const std::string& base_link, double offset)
+{
+  geometry_msgs::TwistStamped target;
+  target.header.frame_id = base_link;
+  target.twist.linear.x = offset;
+  target.twist.angular.z = 2.0 * offset;
+  return target;
+}
+
+/**
+ * @brief A target wrench that grows with the given offset
+ */
+inline geometry_msgs::WrenchStamped targetWrench(double offset)
+{
+  geometry_msgs::WrenchStamped target;
+  target.wrench.force.x = 100.0 * offset;
+  target.wrench.force.z = -100.0 * offset;
+  target.wrench.torque.y = 10.0 * offset;
+  return target;
+}
+
+//! How the fixtures command their motion targets
+enum class TargetInput
+{
+  POSE,   ///< On target_frame
+  PATH,   ///< Streamed on target_path
+  TWIST   ///< On target_twist
+};
+
+/**
+ * @brief Give benchmarks and tests access to a controller's inputs and trackers
+ *
+ * The targets of each controller are given with respect to its end effector
+ * pose when starting, so that they don't depend on the solver's state.
+ * Functions for inputs that the controller doesn't have are only
+ * instantiated when used.
+ *
+ * @tparam Controller One of the Cartesian controllers
+ */
+template <class Controller>
+class Fixture : public Controller
+{
+  public:
+    typedef typename Controller::Base Base;
+    using Base::getAllocationTracker;
+    using Base::resetAllocationTrackers;
+    using Base::selectIKSolver;
+
+    void starting(const ros::Time& time)
+    {
+      Controller::starting(time);
+      m_origin = this->m_ik_solver->getEndEffectorPose();
+    }
+
+    //! The trackers of all threads that run the controller
+    std::vector<cartesian_controller_base::AllocationTracker*> getAllocationTrackers()
+    {
+      std::vector<cartesian_controller_base::AllocationTracker*> trackers;
+      for (auto tracker : {Base::getAllocationTracker(), Base::getAsyncAllocationTracker()})
+      {
+        if (tracker)
+        {
+          trackers.push_back(tracker);
+        }
+      }
+      return trackers;
+    }
+
+    void setTargetInput(TargetInput input) { m_input = input; }
+
+    /**
+     * @brief Publish this many sensor wrenches per control cycle
+     *
+     * Only controllers with force control read them.
+     */
+    void setSensorSamples(int samples) { m_sensor_samples = samples; }
+
+    //! The sensor wrenches of one control cycle
+    void feedSensors(const ros::Time& time, const ros::Duration& period) {}
+
+  protected:
+    void commandMotionTarget(double offset, const ros::Time& time)
+    {
+      switch (m_input)
+      {
+        case TargetInput::PATH:
+          this->targetPathCallback(targetPath(m_origin, this->m_robot_base_link, offset, time));
+          break;
+        case TargetInput::TWIST:
+          this->targetTwistCallback(targetTwist(this->m_robot_base_link, offset));
+          break;
+        default:
+          this->targetFrameCallback(targetPose(m_origin, this->m_robot_base_link, offset));
+          break;
+      }
+    }
+
+    void commandForceTarget(double offset)
+    {
+      this->targetWrenchCallback(targetWrench(offset));
+    }
+
+    /**
+     * @brief A noisy contact force, as if from a sensor that is faster than the controller
+     */
+    void feedSensorWrenches(const ros::Time& time, const ros::Duration& period)
+    {
+      for (int i = 0; i < m_sensor_samples; ++i)
+      {
+        m_sensor_wrench.header.stamp = time + period * (static_cast<double>(i) / m_sensor_samples);
+        m_sensor_wrench.wrench.force.z = -5.0 + 0.5 * std::sin(++m_sensor_cycle * 0.7);
+        m_sensor_wrench.wrench.torque.x = 0.1 * std::cos(m_sensor_cycle * 0.3);
+        this->ftSensorWrenchCallback(m_sensor_wrench);
+      }
+    }
+
+    KDL::Frame  m_origin;
+    TargetInput m_input = TargetInput::POSE;
+    int         m_sensor_samples = 0;
+    int         m_sensor_cycle = 0;
+    geometry_msgs::WrenchStamped m_sensor_wrench;
+};
+
+template <class HardwareInterface>
+class MotionController
+  : public Fixture<cartesian_motion_controller::CartesianMotionController<HardwareInterface> >
+{
+  public:
+    void setTargetOffset(double offset, const ros::Time& time)
+    {
+      this->commandMotionTarget(offset, time);
+    }
+};
+
+template <class HardwareInterface>
+class ForceController
+  : public Fixture<cartesian_force_controller::CartesianForceController<HardwareInterface> >
+{
+  public:
+    void setTargetOffset(double offset, const ros::Time& time)
+    {
+      this->commandForceTarget(offset);
+    }
+
+    void feedSensors(const ros::Time& time, const ros::Duration& period)
+    {
+      this->feedSensorWrenches(time, period);
+    }
+};
+
+template <class HardwareInterface>
+class ComplianceController
+  : public Fixture<cartesian_compliance_controller::CartesianComplianceController<HardwareInterface> >
+{
+  public:
+    void setTargetOffset(double offset, const ros::Time& time)
+    {
+      this->commandMotionTarget(offset, time);
+      this->commandForceTarget(offset);
+    }
+
+    void feedSensors(const ros::Time& time, const ros::Duration& period)
+    {
+      this->feedSensorWrenches(time, period);
+    }
+};
+
+/**
+ * @brief The same interface for the MultiChainMotionController
+ *
+ * Configure its chains with \ref setChainParameters.  All chains get
+ * target poses.
+ */
+template <class HardwareInterface>
+class MultiChainController
+  : public cartesian_motion_controller::MultiChainMotionController<HardwareInterface>
+{
+  public:
+    void starting(const ros::Time& time)
+    {
+      cartesian_motion_controller::MultiChainMotionController<HardwareInterface>::starting(time);
+      m_origins.clear();
+      for (auto& chain : this->m_chains)
+      {
+        m_origins.push_back(chain->getEndEffectorPose());
+      }
+    }
+
+    std::vector<cartesian_controller_base::AllocationTracker*> getAllocationTrackers()
+    {
+      std::vector<cartesian_controller_base::AllocationTracker*> trackers;
+      for (auto& chain : this->m_chains)
+      {
+        if (chain->getAllocationTracker())
+        {
+          trackers.push_back(chain->getAllocationTracker());
+        }
+      }
+      return trackers;
+    }
+
+    void resetAllocationTrackers()
+    {
+      for (auto& chain : this->m_chains)
+      {
+        chain->resetAllocationTrackers();
+      }
+    }
+
+    void setTargetOffset(double offset, const ros::Time& time)
+    {
+      for (size_t i = 0; i < this->m_chains.size(); ++i)
+      {
+        this->m_chains[i]->targetFrameCallback(
+            targetPose(m_origins[i], this->m_chains[i]->getRobotBaseLink(), offset));
+      }
+    }
+
+    void feedSensors(const ros::Time& time, const ros::Duration& period) {}
+
+  private:
+    std::vector<KDL::Frame> m_origins;
+};
+
+}
+
+#endif
@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    controller_benchmarks.cpp
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+// this package
+#include "benchmark_utility.h"
+
+// Other
+#include <benchmark/benchmark.h>
+
+namespace cartesian_controller_benchmarks
+{
+
+/**
+ * @brief The full update() of a controller on the mock hardware
+ *
+ * The hardware follows the commands immediately.  The target jumps back and
+ * forth every few hundred cycles, so that the controller always has something
+ * to do.  The counter \a allocations reports heap allocations per update,
+ * which should be zero.
+ */
+template <class Controller, class HardwareInterface>
+static void BM_ControllerUpdate(benchmark::State& state, const std::string& ik_solver)
+{
+  static int instance = 0;
+  const int joints = state.range(0);
+  const std::string ns = ros::this_node::getName() + "/controller_" + std::to_string(instance++);
+  setControllerParameters(ns, joints, ik_solver);
+
+  MockHardware hw(joints);
+  ros::NodeHandle nh(ns);
+  Controller controller;
+  if (!controller.init(hw.get<HardwareInterface>(), nh))
+  {
+    state.SkipWithError("Failed to initialize the controller");
+    return;
+  }
+
+  const ros::Duration period(0.002);
+  ros::Time time = ros::Time::now();
+  controller.starting(time);
+
+  int cycle = 0;
+  double offset = 0.05;
+  cartesian_controller_base::AllocationTracker tracker;
+  cartesian_controller_base::AllocationTracker::Scope allocations(&tracker);
+  for (auto _ : state)
+  {
+    if (cycle++ % 500 == 0)
+    {
+      state.PauseTiming();
+      offset = -offset;
+      controller.setTargetOffset(offset, time);
+      state.ResumeTiming();
+    }
+
+    time += period;
+    controller.update(time, period);
+    hw.write<HardwareInterface>(period);
+  }
+  state.counters["allocations"] = benchmark::Counter(
+      tracker.getAllocations(), benchmark::Counter::kAvgIterations);
+
+  controller.stopping(time);
+}
+
+template <template <class> class Controller, class HardwareInterface>
+static void registerControllerBenchmark(const std::string& name, const std::string& ik_solver)
+{
+  benchmark::RegisterBenchmark(
+      ("BM_ControllerUpdate/" + name + "/" + ik_solver).c_str(),
+      BM_ControllerUpdate<Controller<HardwareInterface>, HardwareInterface>,
+      ik_solver)
+    ->Arg(6)->Arg(7)->Arg(12);
+}
+
+void registerControllerBenchmarks()
+{
+  using hardware_interface::PositionJointInterface;
+  using hardware_interface::VelocityJointInterface;
+
+  registerControllerBenchmark<MotionController, PositionJointInterface>("motion_position", "forward_dynamics");
+  registerControllerBenchmark<MotionController, VelocityJointInterface>("motion_velocity", "forward_dynamics");
+  registerControllerBenchmark<MotionController, PositionJointInterface>("motion_position", "damped_least_squares");
+  registerControllerBenchmark<ForceController, PositionJointInterface>("force_position", "forward_dynamics");
+  registerControllerBenchmark<ForceController, VelocityJointInterface>("force_velocity", "forward_dynamics");
+  registerControllerBenchmark<ComplianceController, PositionJointInterface>("compliance_position", "forward_dynamics");
+  registerControllerBenchmark<ComplianceController, VelocityJointInterface>("compliance_velocity", "forward_dynamics");
+}
+
+}
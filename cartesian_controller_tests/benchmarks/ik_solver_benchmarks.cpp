@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    ik_solver_benchmarks.cpp
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+// this package
+#include "benchmark_utility.h"
+
+// Project
+#include <cartesian_controller_base/IKSolver.h>
+#include <cartesian_controller_base/Utility.h>
+
+// ROS
+#include <kdl_parser/kdl_parser.hpp>
+#include <pluginlib/class_loader.h>
+
+// KDL
+#include <kdl/chain.hpp>
+#include <kdl/jntarray.hpp>
+#include <kdl/jntarrayvel.hpp>
+#include <kdl/tree.hpp>
+
+// Other
+#include <benchmark/benchmark.h>
+#include <memory>
+
+namespace cartesian_controller_benchmarks
+{
+
+/**
+ * @brief One simulation step of an IK solver, as the controllers call it
+ *
+ * Each iteration synchronizes the solver with the (static) robot, applies a
+ * constant net force and updates the solver's kinematics.  The counter \a
+ * allocations reports heap allocations per step, which should be zero.
+ */
+static void BM_IKSolverStep(benchmark::State& state, const std::string& ik_solver)
+{
+  const int joints = state.range(0);
+
+  // Parse the generic robot
+  KDL::Tree tree;
+  KDL::Chain chain;
+  if (!kdl_parser::treeFromString(robotDescription(joints), tree) ||
+      !tree.getChain("base_link", "tool0", chain))
+  {
+    state.SkipWithError("Failed to parse the benchmark robot");
+    return;
+  }
+  KDL::JntArray upper_pos_limits(joints);
+  KDL::JntArray lower_pos_limits(joints);
+  for (int i = 0; i < joints; ++i)
+  {
+    upper_pos_limits(i) = 3.14;
+    lower_pos_limits(i) = -3.14;
+  }
+
+  // Load the solver through its plugin, like the controllers do
+  pluginlib::ClassLoader<cartesian_controller_base::IKSolver> loader(
+      "cartesian_controller_base", "cartesian_controller_base::IKSolver");
+  std::shared_ptr<cartesian_controller_base::IKSolver> solver;
+  try
+  {
+    solver = loader.createUniqueInstance(ik_solver);
+  }
+  catch (pluginlib::PluginlibException& ex)
+  {
+    state.SkipWithError(ex.what());
+    return;
+  }
+
+  ros::NodeHandle nh("/benchmark/" + ik_solver + "_" + std::to_string(joints));
+  if (!solver->init(nh, chain, upper_pos_limits, lower_pos_limits))
+  {
+    state.SkipWithError("Failed to initialize the solver");
+    return;
+  }
+
+  MockHardware hw(joints);
+  std::vector<hardware_interface::JointHandle> handles;
+  for (const std::string& name : jointNames(joints))
+  {
+    handles.push_back(hw.get<hardware_interface::PositionJointInterface>()->getHandle(name));
+  }
+  solver->setStartState(handles);
+
+  const ros::Duration period(0.02);
+  ctrl::Vector6D net_force;
+  net_force << 1.0, -1.0, 0.5, 0.1, -0.1, 0.05;
+  KDL::JntArrayVel cmds(joints);
+
+  cartesian_controller_base::AllocationTracker tracker;
+  cartesian_controller_base::AllocationTracker::Scope allocations(&tracker);
+  for (auto _ : state)
+  {
+    solver->synchronizeJointPositions(handles);
+    solver->getJointControlCmds(period, net_force, cmds);
+    solver->updateKinematics();
+    benchmark::DoNotOptimize(cmds.qdot.data.data());
+  }
+  state.counters["allocations"] = benchmark::Counter(
+      tracker.getAllocations(), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_CAPTURE(BM_IKSolverStep, forward_dynamics, std::string("forward_dynamics"))
+  ->Arg(6)->Arg(7)->Arg(12);
+BENCHMARK_CAPTURE(BM_IKSolverStep, damped_least_squares, std::string("damped_least_squares"))
+  ->Arg(6)->Arg(7)->Arg(12);
+BENCHMARK_CAPTURE(BM_IKSolverStep, selectively_damped_least_squares, std::string("selectively_damped_least_squares"))
+  ->Arg(6)->Arg(7)->Arg(12);
+BENCHMARK_CAPTURE(BM_IKSolverStep, hybrid_damped_least_squares, std::string("hybrid_damped_least_squares"))
+  ->Arg(6)->Arg(7)->Arg(12);
+BENCHMARK_CAPTURE(BM_IKSolverStep, jacobian_transpose, std::string("jacobian_transpose"))
+  ->Arg(6)->Arg(7)->Arg(12);
+
+}
@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    main.cpp
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+// this package
+#include "benchmark_utility.h"
+
+// Project
+#include <cartesian_controller_base/AllocationHooks.h>
+
+// Other
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+int main(int argc, char** argv)
+{
+  ros::init(argc, argv, "cartesian_controller_benchmarks", ros::init_options::AnonymousName);
+
+  // The solvers and controllers read their configuration from the parameter
+  // server and set up dynamic reconfigure.  Nothing else of ROS is needed.
+  // All parameters go into our private namespace.
+  if (!ros::master::check())
+  {
+    ROS_ERROR("The benchmarks need a running roscore for parameters. "
+              "Use benchmarks.test to start them with their own.");
+    return 1;
+  }
+  ros::NodeHandle nh;  // Keep ROS alive during the benchmarks
+
+  // When started by rostest, report the run in the expected result file
+  std::string result_file;
+  const char* result_flag = "--gtest_output=xml:";
+  for (int i = 1; i < argc; ++i)
+  {
+    if (std::strncmp(argv[i], result_flag, std::strlen(result_flag)) == 0)
+    {
+      result_file = argv[i] + std::strlen(result_flag);
+      std::copy(argv + i + 1, argv + argc, argv + i);
+      --argc;
+      break;
+    }
+  }
+
+  cartesian_controller_benchmarks::registerControllerBenchmarks();
+
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+
+  if (!result_file.empty())
+  {
+    std::ofstream result(result_file);
+    result << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+           << "<testsuite name=\"benchmarks\" tests=\"1\" failures=\"0\" errors=\"0\">\n"
+           << "  <testcase classname=\"benchmarks\" name=\"run\" status=\"run\"/>\n"
+           << "</testsuite>\n";
+  }
+
+  // Clean up what we put on the parameter server
+  ros::param::del(ros::this_node::getName());
+  return 0;
+}
@@ -0,0 +1,463 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    main.cpp
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+// this package
+#include "replay_hardware.h"
+#include "replay_log.h"
+
+// Project
+#include <cartesian_motion_controller/cartesian_motion_controller.h>
+#include <cartesian_force_controller/cartesian_force_controller.h>
+#include <cartesian_compliance_controller/cartesian_compliance_controller.h>
+
+// ROS
+#include <geometry_msgs/PoseStamped.h>
+#include <ros/ros.h>
+
+// Other
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sched.h>
+#include <sstream>
+
+namespace cartesian_controller_replay
+{
+
+using cartesian_controller_base::StageStatistics;
+
+//! Names of the controller stages, as in the StageTimings message
+const char* const STAGE_NAMES[] = {
+  "synchronization",
+  "error_computation",
+  "pd_control",
+  "ik_solver",
+  "kinematics",
+  "write_commands",
+  "null_space"
+};
+
+/**
+ * @brief Give the replay access to the base's statistics
+ */
+template <class Controller>
+class Replayed : public Controller
+{
+  public:
+    typedef typename Controller::Base Base;
+
+    static constexpr int STAGES = Base::NUMBER_OF_STAGES + 1;  // With null space
+
+    using Base::collectStageTimings;
+    using Base::getStageStatistics;
+    using Base::getIterationsDone;
+    using Base::getLastErrorNorm;
+    using Base::hasConverged;
+};
+
+/**
+ * @brief Feed targets to the motion controller and report its pose offset
+ */
+template <class HardwareInterface>
+class MotionController
+  : public Replayed<cartesian_motion_controller::CartesianMotionController<HardwareInterface> >
+{
+  public:
+    void setTargetPose(const geometry_msgs::PoseStamped& target)
+    {
+      this->targetFrameCallback(target);
+    }
+
+    double trackingError()
+    {
+      return this->computeMotionError().norm();
+    }
+};
+
+/**
+ * @brief The force controller has no target poses. Report its net force
+ */
+template <class HardwareInterface>
+class ForceController
+  : public Replayed<cartesian_force_controller::CartesianForceController<HardwareInterface> >
+{
+  public:
+    void setTargetPose(const geometry_msgs::PoseStamped& target)
+    {
+    }
+
+    double trackingError()
+    {
+      return this->computeForceError().norm();
+    }
+};
+
+/**
+ * @brief Feed targets to the compliance controller and report its pose offset
+ *
+ * In contact, the offset settles where stiffness and contact wrench balance.
+ */
+template <class HardwareInterface>
+class ComplianceController
+  : public Replayed<cartesian_compliance_controller::CartesianComplianceController<HardwareInterface> >
+{
+  public:
+    void setTargetPose(const geometry_msgs::PoseStamped& target)
+    {
+      this->targetFrameCallback(target);
+    }
+
+    double trackingError()
+    {
+      return this->computeMotionError().norm();
+    }
+};
+
+struct ReplayOptions
+{
+  std::string   base_link;
+  ros::Duration period;
+  bool          closed_loop;
+  double        settle_tolerance;  ///< For the tracking error
+};
+
+void printStatistics(const std::string& name, const StageStatistics& statistics)
+{
+  std::cout << "  " << name << ": {count: " << statistics.count()
+            << ", min: " << statistics.min()
+            << ", mean: " << statistics.mean()
+            << ", p99: " << statistics.percentile(0.99)
+            << ", max: " << statistics.max() << "}\n";
+}
+
+/**
+ * @brief Run a controller through the log and print a report
+ *
+ * The controller starts at the first recorded joint state.  Each control
+ * cycle applies all events up to the cycle's time, updates the controller
+ * and takes its statistics.  ROS time follows the replay.  Nothing is spun,
+ * so topics don't interfere with the recorded inputs.
+ *
+ * @return False if the controller could not be initialized
+ */
+template <class Controller, class HardwareInterface>
+bool replay(const ReplayLog& log, ReplayHardware& hw, ros::NodeHandle& nh, const ReplayOptions& options)
+{
+  const std::vector<ReplayEvent>& events = log.getEvents();
+  ros::Time time = events.front().stamp;
+  ros::Time::setNow(time);
+  hw.setJointState(std::find_if(events.begin(), events.end(),
+        [](const ReplayEvent& event){ return event.type == ReplayEvent::JOINT_STATE; })->data);
+
+  Controller controller;
+  ros::NodeHandle root_nh;
+  controller_interface::ControllerBase::ClaimedResources claimed_resources;
+  if (!controller.initRequest(&hw, root_nh, nh, claimed_resources))
+  {
+    ROS_ERROR_STREAM("Failed to initialize the controller in " << nh.getNamespace());
+    return false;
+  }
+  controller.collectStageTimings(true);
+  controller.starting(time);
+
+  geometry_msgs::PoseStamped target;
+  target.header.frame_id = options.base_link;
+
+  StageStatistics update_timings;
+  uint64_t cycles = 0;
+  double error = 0.0;
+  double error_sum = 0.0;
+  double error_max = 0.0;
+  uint64_t iterations_sum = 0;
+  int iterations_max = 0;
+  uint64_t converged_cycles = 0;
+  uint64_t converged_iterations = 0;
+
+  // Control cycles from each new target until the error falls below tolerance
+  bool settling = false;
+  uint64_t settling_cycles = 0;
+  uint64_t targets = 0;
+  uint64_t settled = 0;
+  uint64_t settled_cycles_sum = 0;
+  uint64_t settled_cycles_max = 0;
+
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  size_t next = 0;
+  while (next < events.size())
+  {
+    for (; next < events.size() && events[next].stamp <= time; ++next)
+    {
+      const ReplayEvent& event = events[next];
+      switch (event.type)
+      {
+        case ReplayEvent::JOINT_STATE:
+          if (!options.closed_loop)
+          {
+            hw.setJointState(event.data);
+          }
+          break;
+        case ReplayEvent::TARGET_POSE:
+          target.header.stamp = event.stamp;
+          target.pose.position.x = event.data[0];
+          target.pose.position.y = event.data[1];
+          target.pose.position.z = event.data[2];
+          target.pose.orientation.x = event.data[3];
+          target.pose.orientation.y = event.data[4];
+          target.pose.orientation.z = event.data[5];
+          target.pose.orientation.w = event.data[6];
+          controller.setTargetPose(target);
+          settling = true;
+          settling_cycles = 0;
+          ++targets;
+          break;
+        case ReplayEvent::SENSOR_WRENCH:
+          hw.setWrench(event.data);
+          break;
+      }
+    }
+
+    ros::Time::setNow(time);
+    const std::chrono::steady_clock::time_point update_start = std::chrono::steady_clock::now();
+    controller.update(time, options.period);
+    update_timings.record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - update_start).count());
+    if (options.closed_loop)
+    {
+      hw.write<HardwareInterface>(options.period);
+    }
+
+    ++cycles;
+    error = controller.trackingError();
+    error_sum += error;
+    error_max = std::max(error_max, error);
+    iterations_sum += controller.getIterationsDone();
+    iterations_max = std::max(iterations_max, controller.getIterationsDone());
+    if (controller.hasConverged())
+    {
+      ++converged_cycles;
+      converged_iterations += controller.getIterationsDone();
+    }
+    if (settling)
+    {
+      ++settling_cycles;
+      if (error < options.settle_tolerance)
+      {
+        ++settled;
+        settled_cycles_sum += settling_cycles;
+        settled_cycles_max = std::max(settled_cycles_max, settling_cycles);
+        settling = false;
+      }
+    }
+
+    time += options.period;
+  }
+  const std::chrono::duration<double> wall_time = std::chrono::steady_clock::now() - start;
+  controller.stopping(time);
+
+  const double replayed = (time - events.front().stamp).toSec();
+  std::cout << "cycles: " << cycles << "\n"
+            << "replayed_time: " << replayed << "\n"
+            << "wall_time: " << wall_time.count() << "\n"
+            << "real_time_factor: " << replayed / wall_time.count() << "\n"
+            << "tracking_error: {mean: " << error_sum / cycles
+            << ", max: " << error_max << ", final: " << error << "}\n"
+            << "iterations: {mean: " << static_cast<double>(iterations_sum) / cycles
+            << ", max: " << iterations_max
+            << ", converged_cycles: " << converged_cycles
+            << ", mean_to_converge: "
+            << (converged_cycles ? static_cast<double>(converged_iterations) / converged_cycles : 0.0)
+            << ", final_error_norm: " << controller.getLastErrorNorm() << "}\n"
+            << "settling_cycles: {targets: " << targets
+            << ", settled: " << settled
+            << ", mean: " << (settled ? static_cast<double>(settled_cycles_sum) / settled : 0.0)
+            << ", max: " << settled_cycles_max << "}\n"
+            << "stage_timings:\n";
+  for (int i = 0; i < Controller::STAGES; ++i)
+  {
+    printStatistics(STAGE_NAMES[i], controller.getStageStatistics(i));
+  }
+  printStatistics("update", update_timings);
+  return true;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+  using namespace cartesian_controller_replay;
+  using hardware_interface::PositionJointInterface;
+  using hardware_interface::VelocityJointInterface;
+
+  ros::init(argc, argv, "cartesian_controller_replay");
+
+  // The controllers read their configuration from the parameter server and
+  // set up dynamic reconfigure.  Nothing else of ROS is needed.
+  if (!ros::master::check())
+  {
+    ROS_ERROR("The replay needs a running roscore for parameters.");
+    return 1;
+  }
+  ros::NodeHandle nh("~");
+
+  std::string log_path;
+  std::string controller_name;
+  if (!nh.getParam("log", log_path) || !nh.getParam("controller", controller_name))
+  {
+    ROS_ERROR_STREAM("Set " << nh.getNamespace() << "/log to the recorded file and "
+                     << nh.getNamespace() << "/controller to the controller's configuration");
+    return 1;
+  }
+  ros::NodeHandle controller_nh(nh, controller_name);
+
+  std::string type;
+  std::vector<std::string> joints;
+  if (!controller_nh.getParam("type", type) || !controller_nh.getParam("joints", joints))
+  {
+    ROS_ERROR_STREAM("Failed to load the type and joints of " << controller_nh.getNamespace());
+    return 1;
+  }
+
+  // The controllers search robot_description from their namespace upwards
+  std::string urdf;
+  if (nh.getParam("urdf", urdf))
+  {
+    std::ifstream file(urdf);
+    std::stringstream robot_description;
+    robot_description << file.rdbuf();
+    if (!file)
+    {
+      ROS_ERROR_STREAM("Failed to read " << urdf);
+      return 1;
+    }
+    nh.setParam("robot_description", robot_description.str());
+  }
+
+  // Read the log
+  ReplayLog log;
+  const bool is_bag = log_path.size() > 4 && log_path.compare(log_path.size() - 4, 4, ".bag") == 0;
+  if (is_bag)
+  {
+    // Default to the topics of the recorded controller of the same name
+    const std::string joint_state_topic = nh.param<std::string>("joint_state_topic", "/joint_states");
+    const std::string target_topic = nh.param<std::string>(
+        "target_topic", "/" + controller_name + "/" + controller_nh.param<std::string>("target_frame_topic", "target_frame"));
+    const std::string wrench_topic = nh.param<std::string>(
+        "wrench_topic", "/" + controller_name + "/ft_sensor_wrench");
+    if (!log.readBag(log_path, joints, joint_state_topic, target_topic, wrench_topic))
+    {
+      return 1;
+    }
+  }
+  else if (!log.read(log_path))
+  {
+    return 1;
+  }
+  if (log.getJointNames() != joints)
+  {
+    ROS_ERROR_STREAM(log_path << " doesn't have the joints of " << controller_nh.getNamespace());
+    return 1;
+  }
+  if (log.getEvents().empty())
+  {
+    ROS_ERROR_STREAM(log_path << " is empty");
+    return 1;
+  }
+
+  std::string convert;
+  if (nh.getParam("convert", convert))
+  {
+    return log.write(convert) ? 0 : 1;
+  }
+
+  // Pin to a core for comparable timings when sweeping in parallel
+  const int cpu = nh.param("cpu", -1);
+  if (cpu >= 0)
+  {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu, &cpu_set);
+    if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0)
+    {
+      ROS_ERROR_STREAM("Failed to pin the replay to CPU " << cpu);
+      return 1;
+    }
+  }
+
+  ReplayOptions options;
+  options.base_link = controller_nh.param<std::string>("robot_base_link", "");
+  options.period = ros::Duration(1.0 / nh.param("rate", 500.0));
+  options.closed_loop = nh.param("closed_loop", false);
+  options.settle_tolerance = nh.param("settle_tolerance", 0.001);
+
+  // There are no sensor topics in the replay. Recorded wrenches come from the hardware.
+  std::string ft_sensor = controller_nh.param<std::string>("ft_sensor_handle", "replay_ft_sensor");
+  controller_nh.setParam("ft_sensor_handle", ft_sensor);
+  ReplayHardware hw(joints, ft_sensor, controller_nh.param<std::string>("ft_sensor_ref_link", ""));
+
+  typedef std::function<bool(const ReplayLog&, ReplayHardware&, ros::NodeHandle&, const ReplayOptions&)> Replay;
+  const std::map<std::string, Replay> replays = {
+    {"position_controllers/CartesianMotionController",
+      replay<MotionController<PositionJointInterface>, PositionJointInterface>},
+    {"velocity_controllers/CartesianMotionController",
+      replay<MotionController<VelocityJointInterface>, VelocityJointInterface>},
+    {"position_controllers/CartesianForceController",
+      replay<ForceController<PositionJointInterface>, PositionJointInterface>},
+    {"velocity_controllers/CartesianForceController",
+      replay<ForceController<VelocityJointInterface>, VelocityJointInterface>},
+    {"position_controllers/CartesianComplianceController",
+      replay<ComplianceController<PositionJointInterface>, PositionJointInterface>},
+    {"velocity_controllers/CartesianComplianceController",
+      replay<ComplianceController<VelocityJointInterface>, VelocityJointInterface>},
+  };
+  auto it = replays.find(type);
+  if (it == replays.end())
+  {
+    ROS_ERROR_STREAM("The replay doesn't support controllers of type " << type);
+    return 1;
+  }
+
+  std::cout << "controller: " << controller_name << "\n"
+            << "type: " << type << "\n"
+            << "log: " << log_path << "\n"
+            << "rate: " << 1.0 / options.period.toSec() << "\n"
+            << "closed_loop: " << (options.closed_loop ? "true" : "false") << "\n";
+  return it->second(log, hw, controller_nh, options) ? 0 : 1;
+}
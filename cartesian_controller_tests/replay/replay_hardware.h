@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    replay_hardware.h
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef REPLAY_HARDWARE_H_INCLUDED
+#define REPLAY_HARDWARE_H_INCLUDED
+
+// ROS
+#include <ros/duration.h>
+
+// ros_controls
+#include <hardware_interface/force_torque_sensor_interface.h>
+#include <hardware_interface/joint_command_interface.h>
+#include <hardware_interface/joint_state_interface.h>
+#include <hardware_interface/robot_hw.h>
+
+// Other
+#include <string>
+#include <vector>
+
+namespace cartesian_controller_replay
+{
+
+/**
+ * @brief A robot hardware whose state comes from a log
+ *
+ * Offers position and velocity interfaces for the given joints and one
+ * force-torque sensor.  In open loop, the joint state is whatever the log
+ * says and commands have no effect.  In closed loop, \ref write feeds the
+ * commands back into the joint state, as if the robot followed perfectly.
+ */
+class ReplayHardware : public hardware_interface::RobotHW
+{
+  public:
+    ReplayHardware(const std::vector<std::string>& joints,
+                   const std::string& ft_sensor,
+                   const std::string& ft_sensor_frame)
+      : m_positions(joints.size(), 0.0), m_velocities(joints.size(), 0.0),
+        m_efforts(joints.size(), 0.0), m_position_cmds(joints.size(), 0.0),
+        m_velocity_cmds(joints.size(), 0.0), m_force{0, 0, 0}, m_torque{0, 0, 0}
+    {
+      for (size_t i = 0; i < joints.size(); ++i)
+      {
+        m_state_interface.registerHandle(hardware_interface::JointStateHandle(
+              joints[i], &m_positions[i], &m_velocities[i], &m_efforts[i]));
+        m_position_interface.registerHandle(hardware_interface::JointHandle(
+              m_state_interface.getHandle(joints[i]), &m_position_cmds[i]));
+        m_velocity_interface.registerHandle(hardware_interface::JointHandle(
+              m_state_interface.getHandle(joints[i]), &m_velocity_cmds[i]));
+      }
+      m_ft_sensor_interface.registerHandle(hardware_interface::ForceTorqueSensorHandle(
+            ft_sensor, ft_sensor_frame, m_force, m_torque));
+
+      registerInterface(&m_state_interface);
+      registerInterface(&m_position_interface);
+      registerInterface(&m_velocity_interface);
+      registerInterface(&m_ft_sensor_interface);
+    }
+
+    //! Take a recorded joint state with positions, then velocities
+    void setJointState(const std::vector<double>& state)
+    {
+      const size_t joints = m_positions.size();
+      for (size_t i = 0; i < joints; ++i)
+      {
+        m_positions[i] = state[i];
+        m_velocities[i] = state[joints + i];
+        m_position_cmds[i] = m_positions[i];
+      }
+    }
+
+    //! Take a recorded sensor wrench with force, then torque
+    void setWrench(const std::vector<double>& wrench)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        m_force[i] = wrench[i];
+        m_torque[i] = wrench[3 + i];
+      }
+    }
+
+    //! Apply the last commands of the given interface to the joint state
+    template <class HardwareInterface>
+    void write(const ros::Duration& period);
+
+  private:
+    std::vector<double> m_positions;
+    std::vector<double> m_velocities;
+    std::vector<double> m_efforts;
+    std::vector<double> m_position_cmds;
+    std::vector<double> m_velocity_cmds;
+    double              m_force[3];
+    double              m_torque[3];
+
+    hardware_interface::JointStateInterface        m_state_interface;
+    hardware_interface::PositionJointInterface     m_position_interface;
+    hardware_interface::VelocityJointInterface     m_velocity_interface;
+    hardware_interface::ForceTorqueSensorInterface m_ft_sensor_interface;
+};
+
+template <>
+inline void ReplayHardware::write<hardware_interface::PositionJointInterface>(const ros::Duration& period)
+{
+  for (size_t i = 0; i < m_positions.size(); ++i)
+  {
+    m_velocities[i] = (m_position_cmds[i] - m_positions[i]) / period.toSec();
+    m_positions[i] = m_position_cmds[i];
+  }
+}
+
+template <>
+inline void ReplayHardware::write<hardware_interface::VelocityJointInterface>(const ros::Duration& period)
+{
+  for (size_t i = 0; i < m_positions.size(); ++i)
+  {
+    m_velocities[i] = m_velocity_cmds[i];
+    m_positions[i] += m_velocity_cmds[i] * period.toSec();
+  }
+}
+
+}
+
+#endif
@@ -0,0 +1,273 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    replay_log.cpp
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+// this package
+#include "replay_log.h"
+
+// ROS
+#include <geometry_msgs/PoseStamped.h>
+#include <geometry_msgs/WrenchStamped.h>
+#include <ros/console.h>
+#include <rosbag/bag.h>
+#include <rosbag/view.h>
+#include <sensor_msgs/JointState.h>
+
+// Other
+#include <algorithm>
+#include <fstream>
+
+namespace cartesian_controller_replay
+{
+
+bool ReplayLog::readBag(const std::string& path,
+                        const std::vector<std::string>& joints,
+                        const std::string& joint_state_topic,
+                        const std::string& target_topic,
+                        const std::string& wrench_topic)
+{
+  m_joint_names = joints;
+  m_events.clear();
+
+  try
+  {
+    rosbag::Bag bag(path, rosbag::bagmode::Read);
+    rosbag::View view(bag, rosbag::TopicQuery(
+          std::vector<std::string>{joint_state_topic, target_topic, wrench_topic}));
+
+    std::vector<int> indices(joints.size());
+    for (const rosbag::MessageInstance& message : view)
+    {
+      ReplayEvent event;
+      if (message.getTopic() == joint_state_topic)
+      {
+        sensor_msgs::JointState::ConstPtr state = message.instantiate<sensor_msgs::JointState>();
+        if (!state)
+        {
+          continue;
+        }
+
+        // Other publishers might share the topic with different joints
+        bool complete = true;
+        for (size_t i = 0; i < joints.size() && complete; ++i)
+        {
+          auto it = std::find(state->name.begin(), state->name.end(), joints[i]);
+          complete = it != state->name.end() && it - state->name.begin() < static_cast<int>(state->position.size());
+          indices[i] = it - state->name.begin();
+        }
+        if (!complete)
+        {
+          continue;
+        }
+
+        event.type = ReplayEvent::JOINT_STATE;
+        event.stamp = state->header.stamp;
+        event.data.resize(2 * joints.size(), 0.0);
+        for (size_t i = 0; i < joints.size(); ++i)
+        {
+          event.data[i] = state->position[indices[i]];
+          if (indices[i] < static_cast<int>(state->velocity.size()))
+          {
+            event.data[joints.size() + i] = state->velocity[indices[i]];
+          }
+        }
+      }
+      else if (message.getTopic() == target_topic)
+      {
+        geometry_msgs::PoseStamped::ConstPtr target = message.instantiate<geometry_msgs::PoseStamped>();
+        if (!target)
+        {
+          continue;
+        }
+        event.type = ReplayEvent::TARGET_POSE;
+        event.stamp = target->header.stamp;
+        event.data = {
+          target->pose.position.x,
+          target->pose.position.y,
+          target->pose.position.z,
+          target->pose.orientation.x,
+          target->pose.orientation.y,
+          target->pose.orientation.z,
+          target->pose.orientation.w};
+      }
+      else
+      {
+        geometry_msgs::WrenchStamped::ConstPtr wrench = message.instantiate<geometry_msgs::WrenchStamped>();
+        if (!wrench)
+        {
+          continue;
+        }
+        event.type = ReplayEvent::SENSOR_WRENCH;
+        event.stamp = wrench->header.stamp;
+        event.data = {
+          wrench->wrench.force.x,
+          wrench->wrench.force.y,
+          wrench->wrench.force.z,
+          wrench->wrench.torque.x,
+          wrench->wrench.torque.y,
+          wrench->wrench.torque.z};
+      }
+
+      if (event.stamp.isZero())
+      {
+        event.stamp = message.getTime();
+      }
+      m_events.push_back(std::move(event));
+    }
+  }
+  catch (const rosbag::BagException& e)
+  {
+    ROS_ERROR_STREAM("Failed to read " << path << ": " << e.what());
+    return false;
+  }
+
+  sortEvents();
+  if (std::none_of(m_events.begin(), m_events.end(),
+        [](const ReplayEvent& event){ return event.type == ReplayEvent::JOINT_STATE; }))
+  {
+    ROS_ERROR_STREAM("Found no joint states of all controller joints on "
+                     << joint_state_topic << " in " << path);
+    return false;
+  }
+  return true;
+}
+
+bool ReplayLog::read(const std::string& path)
+{
+  m_joint_names.clear();
+  m_events.clear();
+
+  std::ifstream file(path, std::ios::binary);
+  uint32_t header[3];
+  if (!file.read(reinterpret_cast<char*>(header), sizeof(header)) ||
+      header[0] != MAGIC || header[1] != VERSION)
+  {
+    ROS_ERROR_STREAM(path << " is no replay log of version " << VERSION);
+    return false;
+  }
+
+  for (uint32_t i = 0; i < header[2]; ++i)
+  {
+    uint32_t length = 0;
+    file.read(reinterpret_cast<char*>(&length), sizeof(length));
+    std::string name(length, '\0');
+    if (!file.read(&name[0], length))
+    {
+      ROS_ERROR_STREAM(path << " ends within its joint names");
+      return false;
+    }
+    m_joint_names.push_back(name);
+  }
+
+  uint8_t type;
+  while (file.read(reinterpret_cast<char*>(&type), sizeof(type)))
+  {
+    if (type > ReplayEvent::SENSOR_WRENCH)
+    {
+      ROS_ERROR_STREAM(path << " contains an unknown event type " << static_cast<int>(type));
+      return false;
+    }
+
+    ReplayEvent event;
+    event.type = static_cast<ReplayEvent::Type>(type);
+    event.data.resize(dataSize(event.type));
+    int64_t stamp = 0;
+    file.read(reinterpret_cast<char*>(&stamp), sizeof(stamp));
+    if (!file.read(reinterpret_cast<char*>(event.data.data()), event.data.size() * sizeof(double)))
+    {
+      ROS_ERROR_STREAM(path << " ends within an event");
+      return false;
+    }
+    event.stamp.fromNSec(stamp);
+    m_events.push_back(std::move(event));
+  }
+
+  sortEvents();
+  return true;
+}
+
+bool ReplayLog::write(const std::string& path) const
+{
+  std::ofstream file(path, std::ios::binary);
+  const uint32_t header[3] = {MAGIC, VERSION, static_cast<uint32_t>(m_joint_names.size())};
+  file.write(reinterpret_cast<const char*>(header), sizeof(header));
+  for (const std::string& name : m_joint_names)
+  {
+    const uint32_t length = name.size();
+    file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    file.write(name.data(), length);
+  }
+
+  for (const ReplayEvent& event : m_events)
+  {
+    const uint8_t type = event.type;
+    const int64_t stamp = event.stamp.toNSec();
+    file.write(reinterpret_cast<const char*>(&type), sizeof(type));
+    file.write(reinterpret_cast<const char*>(&stamp), sizeof(stamp));
+    file.write(reinterpret_cast<const char*>(event.data.data()), event.data.size() * sizeof(double));
+  }
+
+  if (!file)
+  {
+    ROS_ERROR_STREAM("Failed to write " << path);
+    return false;
+  }
+  return true;
+}
+
+size_t ReplayLog::dataSize(ReplayEvent::Type type) const
+{
+  switch (type)
+  {
+    case ReplayEvent::JOINT_STATE:
+      return 2 * m_joint_names.size();
+    case ReplayEvent::TARGET_POSE:
+      return 7;
+    case ReplayEvent::SENSOR_WRENCH:
+      return 6;
+  }
+  return 0;
+}
+
+void ReplayLog::sortEvents()
+{
+  // Keep the recorded order of events with equal stamps
+  std::stable_sort(m_events.begin(), m_events.end(),
+      [](const ReplayEvent& a, const ReplayEvent& b){ return a.stamp < b.stamp; });
+}
+
+}
@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    replay_log.h
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef REPLAY_LOG_H_INCLUDED
+#define REPLAY_LOG_H_INCLUDED
+
+// ROS
+#include <ros/time.h>
+
+// Other
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cartesian_controller_replay
+{
+
+/**
+ * @brief One recorded input of a controller
+ */
+struct ReplayEvent
+{
+  enum Type : uint8_t
+  {
+    JOINT_STATE,    ///< Positions, then velocities of the log's joints
+    TARGET_POSE,    ///< Position, then quaternion x, y, z, w in the robot base link
+    SENSOR_WRENCH,  ///< Force, then torque in the sensor's frame
+  };
+
+  Type                type;
+  ros::Time           stamp;
+  std::vector<double> data;
+};
+
+/**
+ * @brief Recorded joint states, target poses and sensor wrenches
+ *
+ * Logs come either from a rosbag or from a compact binary file.  Converting
+ * a bag once saves the time to search its topics when replaying it many
+ * times.  In both cases, the events are sorted by their stamps.
+ *
+ * Layout of the binary file, in host byte order: the magic number, the
+ * version and the number of joints as uint32. Then for each joint the length
+ * of its name as uint32, followed by the name's characters.  The rest are
+ * events, each with its type as uint8, its stamp in nanoseconds as int64 and
+ * its data as doubles.  The number of doubles follows from the type.
+ */
+class ReplayLog
+{
+  public:
+    static constexpr uint32_t MAGIC = 0x4343524c;  // "CCRL"
+    static constexpr uint32_t VERSION = 1;
+
+    /**
+     * @brief Read the given joints' states, target poses and wrenches from a bag
+     *
+     * Joint states of other joints are ignored. Messages without stamps get
+     * the time at which they were recorded.
+     *
+     * @param path The bag file
+     * @param joints The joints to read, in the controller's order
+     * @param joint_state_topic The topic of sensor_msgs/JointState messages
+     * @param target_topic The topic of geometry_msgs/PoseStamped messages
+     * @param wrench_topic The topic of geometry_msgs/WrenchStamped messages
+     *
+     * @return True, if the bag could be read and contains joint states
+     */
+    bool readBag(const std::string& path,
+                 const std::vector<std::string>& joints,
+                 const std::string& joint_state_topic,
+                 const std::string& target_topic,
+                 const std::string& wrench_topic);
+
+    /**
+     * @brief Read a compact binary log
+     *
+     * @param path The log file
+     *
+     * @return True, if the file is a valid log
+     */
+    bool read(const std::string& path);
+
+    /**
+     * @brief Write this log as compact binary file
+     *
+     * @param path The log file
+     *
+     * @return True on success
+     */
+    bool write(const std::string& path) const;
+
+    //! The number of doubles of an event of the given type
+    size_t dataSize(ReplayEvent::Type type) const;
+
+    const std::vector<std::string>& getJointNames() const { return m_joint_names; }
+    const std::vector<ReplayEvent>& getEvents() const { return m_events; }
+
+  private:
+    void sortEvents();
+
+    std::vector<std::string> m_joint_names;
+    std::vector<ReplayEvent> m_events;
+};
+
+}
+
+#endif
@@ -0,0 +1,162 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    kinematics_cache_tests.cpp
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+// this package
+#include "../benchmarks/benchmark_utility.h"
+
+// Project
+#include <cartesian_controller_base/KinematicsCache.h>
+
+// KDL
+#include <kdl/chainfksolverpos_recursive.hpp>
+#include <kdl/chainjnttojacsolver.hpp>
+#include <kdl/tree.hpp>
+#include <kdl_parser/kdl_parser.hpp>
+
+// Other
+#include <gtest/gtest.h>
+
+using cartesian_controller_base::KinematicsCache;
+using cartesian_controller_benchmarks::robotDescription;
+using cartesian_controller_benchmarks::startPosition;
+
+/**
+ * @brief Compare the cache with KDL's own solvers on the generic robot
+ */
+class KinematicsCacheTest : public testing::TestWithParam<int>
+{
+  protected:
+    void SetUp()
+    {
+      KDL::Tree tree;
+      ASSERT_TRUE(kdl_parser::treeFromString(robotDescription(GetParam()), tree));
+      ASSERT_TRUE(tree.getChain("base_link", "tool0", m_chain));
+      m_cache.init(m_chain);
+    }
+
+    //! Joint positions away from singularities, shifted by \a offset
+    KDL::JntArray positions(double offset) const
+    {
+      KDL::JntArray q(m_chain.getNrOfJoints());
+      for (unsigned int i = 0; i < q.rows(); ++i)
+      {
+        q(i) = startPosition(i) + offset * (i + 1);
+      }
+      return q;
+    }
+
+    KDL::Chain      m_chain;
+    KinematicsCache m_cache;
+};
+
+void expectEqual(const KDL::Frame& expected, const KDL::Frame& actual)
+{
+  EXPECT_TRUE(KDL::Equal(expected, actual, 1e-10))
+    << "Expected p = (" << expected.p.x() << ", " << expected.p.y() << ", " << expected.p.z()
+    << "), got (" << actual.p.x() << ", " << actual.p.y() << ", " << actual.p.z() << ")";
+}
+
+TEST_P(KinematicsCacheTest, endEffectorPose)
+{
+  KDL::ChainFkSolverPos_recursive fk_solver(m_chain);
+  for (double offset : {0.0, 0.3, -1.1})
+  {
+    const KDL::JntArray q = positions(offset);
+    KDL::Frame expected;
+    ASSERT_GE(fk_solver.JntToCart(q, expected), 0);
+
+    m_cache.update(q);
+    expectEqual(expected, m_cache.getEndEffectorPose());
+  }
+}
+
+TEST_P(KinematicsCacheTest, segmentFrames)
+{
+  KDL::ChainFkSolverPos_recursive fk_solver(m_chain);
+  const KDL::JntArray q = positions(0.2);
+  m_cache.update(q);
+  for (unsigned int i = 0; i < m_chain.getNrOfSegments(); ++i)
+  {
+    KDL::Frame expected;
+    ASSERT_GE(fk_solver.JntToCart(q, expected, i + 1), 0);
+    expectEqual(expected, m_cache.getSegmentFrame(i));
+
+    const std::string& name = m_chain.getSegment(i).getName();
+    EXPECT_EQ(static_cast<int>(i), m_cache.getSegmentIndex(name)) << name;
+    expectEqual(expected, m_cache.getSegmentFrame(name));
+  }
+
+  // The chain's root
+  EXPECT_EQ(-1, m_cache.getSegmentIndex("no_such_link"));
+  expectEqual(KDL::Frame::Identity(), m_cache.getSegmentFrame(-1));
+  expectEqual(KDL::Frame::Identity(), m_cache.getSegmentFrame("no_such_link"));
+}
+
+TEST_P(KinematicsCacheTest, jacobian)
+{
+  KDL::ChainJntToJacSolver jac_solver(m_chain);
+  KDL::Jacobian expected(m_chain.getNrOfJoints());
+  for (double offset : {0.0, 0.3, -1.1})
+  {
+    const KDL::JntArray q = positions(offset);
+    ASSERT_GE(jac_solver.JntToJac(q, expected), 0);
+
+    m_cache.update(q);
+    const KDL::Jacobian& actual = m_cache.getJacobian();
+    ASSERT_EQ(expected.rows(), actual.rows());
+    ASSERT_EQ(expected.columns(), actual.columns());
+    EXPECT_TRUE(expected.data.isApprox(actual.data, 1e-10))
+      << "Expected\n" << expected.data << "\ngot\n" << actual.data;
+  }
+}
+
+TEST_P(KinematicsCacheTest, updatesOnlyForNewPositions)
+{
+  const KDL::JntArray q = positions(0.2);
+  EXPECT_TRUE(m_cache.update(q));
+  EXPECT_FALSE(m_cache.update(q));
+  EXPECT_TRUE(m_cache.update(positions(0.3)));
+}
+
+INSTANTIATE_TEST_CASE_P(GenericRobots, KinematicsCacheTest, testing::Values(6, 7, 12));
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
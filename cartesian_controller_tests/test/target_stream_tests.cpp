@@ -0,0 +1,227 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    target_stream_tests.cpp
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+// this package
+#include "../benchmarks/benchmark_utility.h"
+
+// Other
+#include <gtest/gtest.h>
+
+using namespace cartesian_controller_benchmarks;
+using hardware_interface::PositionJointInterface;
+
+/**
+ * @brief Give the tests access to the motion controller's target interpolation
+ */
+class StreamingController : public MotionController<PositionJointInterface>
+{
+  public:
+    void stream(const nav_msgs::Path& path) { this->targetPathCallback(path); }
+
+    void command(const geometry_msgs::PoseStamped& pose) { this->targetFrameCallback(pose); }
+
+    //! The target of the control cycle at \a time
+    const KDL::Frame& target(double time)
+    {
+      this->updateTargetFrame(ros::Time(time));
+      return this->m_target_frame;
+    }
+};
+
+/**
+ * @brief A streamed target at the given position, turned by \a yaw about z
+ */
+geometry_msgs::PoseStamped sample(double x, double y, double z, double yaw, double time)
+{
+  geometry_msgs::PoseStamped pose;
+  pose.header.frame_id = "base_link";
+  pose.header.stamp = ros::Time(time);
+  pose.pose.position.x = x;
+  pose.pose.position.y = y;
+  pose.pose.position.z = z;
+  KDL::Rotation::RotZ(yaw).GetQuaternion(
+      pose.pose.orientation.x,
+      pose.pose.orientation.y,
+      pose.pose.orientation.z,
+      pose.pose.orientation.w);
+  return pose;
+}
+
+nav_msgs::Path path(const std::vector<geometry_msgs::PoseStamped>& samples)
+{
+  nav_msgs::Path path;
+  path.header.frame_id = "base_link";
+  path.poses = samples;
+  return path;
+}
+
+KDL::Frame frame(double x, double y, double z, double yaw)
+{
+  return KDL::Frame(KDL::Rotation::RotZ(yaw), KDL::Vector(x, y, z));
+}
+
+void expectEqual(const KDL::Frame& expected, const KDL::Frame& actual)
+{
+  double roll, pitch, yaw;
+  actual.M.GetRPY(roll, pitch, yaw);
+  EXPECT_TRUE(KDL::Equal(expected, actual, 1e-9))
+    << "Got p = (" << actual.p.x() << ", " << actual.p.y() << ", " << actual.p.z()
+    << "), rpy = (" << roll << ", " << pitch << ", " << yaw << ")";
+}
+
+class TargetStreamTest : public testing::Test
+{
+  protected:
+    TargetStreamTest() : m_hw(6) {}
+
+    void SetUp()
+    {
+      static int instance = 0;
+      const std::string ns = ros::this_node::getName() + "/controller_" + std::to_string(instance++);
+      setControllerParameters(ns, 6, "forward_dynamics");
+      ros::NodeHandle nh(ns);
+      ASSERT_TRUE(m_controller.init(m_hw.get<PositionJointInterface>(), nh));
+      m_controller.starting(ros::Time(1.0));
+    }
+
+    MockHardware        m_hw;
+    StreamingController m_controller;
+};
+
+TEST_F(TargetStreamTest, passesThroughSamples)
+{
+  m_controller.stream(path({
+        sample(0.1, 0.2, 0.3, 0.0, 2.0),
+        sample(0.2, 0.2, 0.4, 0.4, 3.0),
+        sample(0.4, 0.1, 0.4, 0.8, 4.0)}));
+
+  expectEqual(frame(0.1, 0.2, 0.3, 0.0), m_controller.target(2.0));
+  expectEqual(frame(0.2, 0.2, 0.4, 0.4), m_controller.target(3.0));
+  expectEqual(frame(0.4, 0.1, 0.4, 0.8), m_controller.target(4.0));
+}
+
+TEST_F(TargetStreamTest, interpolatesBetweenSamples)
+{
+  // Streams start and end at rest, so a single segment follows
+  // 3 s^2 - 2 s^3 and its midpoint is the mean of its samples.  The
+  // orientation turns at constant speed.
+  m_controller.stream(path({
+        sample(0.1, 0.2, 0.3, 0.0, 2.0),
+        sample(0.3, 0.0, 0.5, 0.8, 3.0)}));
+
+  const double s = 3 * 0.25 * 0.25 - 2 * 0.25 * 0.25 * 0.25;
+  expectEqual(frame(0.1, 0.2, 0.3, 0.0), m_controller.target(2.0));
+  expectEqual(frame(0.1 + 0.2 * s, 0.2 - 0.2 * s, 0.3 + 0.2 * s, 0.2), m_controller.target(2.25));
+  expectEqual(frame(0.2, 0.1, 0.4, 0.4), m_controller.target(2.5));
+  expectEqual(frame(0.3, 0.0, 0.5, 0.8), m_controller.target(3.0));
+}
+
+TEST_F(TargetStreamTest, holdsTheLastSample)
+{
+  m_controller.stream(path({
+        sample(0.1, 0.2, 0.3, 0.0, 2.0),
+        sample(0.3, 0.0, 0.5, 0.8, 3.0)}));
+
+  m_controller.target(2.0);
+  expectEqual(frame(0.3, 0.0, 0.5, 0.8), m_controller.target(3.0));
+  expectEqual(frame(0.3, 0.0, 0.5, 0.8), m_controller.target(3.5));
+  expectEqual(frame(0.3, 0.0, 0.5, 0.8), m_controller.target(4.0));
+
+  // The next sample continues from the held one instead of jumping
+  m_controller.stream(path({sample(0.5, 0.2, 0.5, 0.8, 5.0)}));
+  expectEqual(frame(0.3, 0.0, 0.5, 0.8), m_controller.target(4.0));
+  expectEqual(frame(0.4, 0.1, 0.5, 0.8), m_controller.target(4.5));
+  expectEqual(frame(0.5, 0.2, 0.5, 0.8), m_controller.target(5.0));
+}
+
+TEST_F(TargetStreamTest, otherTargetsTakeOver)
+{
+  m_controller.stream(path({
+        sample(0.1, 0.2, 0.3, 0.0, 2.0),
+        sample(0.3, 0.0, 0.5, 0.8, 3.0)}));
+  m_controller.target(2.0);
+  m_controller.target(3.0);
+
+  m_controller.command(sample(0.0, 0.3, 0.6, 0.2, 0.0));
+  expectEqual(frame(0.0, 0.3, 0.6, 0.2), m_controller.target(3.5));
+  expectEqual(frame(0.0, 0.3, 0.6, 0.2), m_controller.target(4.0));
+}
+
+TEST_F(TargetStreamTest, dropsOutdatedSamples)
+{
+  m_controller.stream(path({
+        sample(0.1, 0.2, 0.3, 0.0, 2.0),
+        sample(0.3, 0.0, 0.5, 0.8, 3.0)}));
+  m_controller.stream(path({sample(0.9, 0.9, 0.9, 0.0, 2.5)}));
+
+  m_controller.target(2.0);
+  expectEqual(frame(0.2, 0.1, 0.4, 0.4), m_controller.target(2.5));
+  expectEqual(frame(0.3, 0.0, 0.5, 0.8), m_controller.target(3.0));
+}
+
+TEST_F(TargetStreamTest, restartsWithEarlierTimeStamps)
+{
+  m_controller.stream(path({
+        sample(0.1, 0.2, 0.3, 0.0, 2.0),
+        sample(0.3, 0.0, 0.5, 0.8, 3.0)}));
+  m_controller.target(2.0);
+  m_controller.target(3.0);
+
+  // A restarted controller accepts streams of any time again, e.g. after
+  // the clock of a simulation was reset
+  m_controller.stopping(ros::Time(3.0));
+  m_controller.starting(ros::Time(1.0));
+  m_controller.stream(path({
+        sample(0.2, 0.3, 0.4, 0.0, 1.5),
+        sample(0.4, 0.1, 0.6, 0.8, 2.5)}));
+
+  expectEqual(frame(0.2, 0.3, 0.4, 0.0), m_controller.target(1.5));
+  expectEqual(frame(0.3, 0.2, 0.5, 0.4), m_controller.target(2.0));
+  expectEqual(frame(0.4, 0.1, 0.6, 0.8), m_controller.target(2.5));
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  ros::init(argc, argv, "target_stream_tests");
+  ros::NodeHandle nh;  // Keep ROS alive during the tests
+
+  const int result = RUN_ALL_TESTS();
+  ros::param::del(ros::this_node::getName());
+  return result;
+}
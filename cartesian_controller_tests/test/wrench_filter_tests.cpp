@@ -0,0 +1,161 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    wrench_filter_tests.cpp
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+// Project
+#include <cartesian_controller_base/WrenchFilter.h>
+
+// Other
+#include <cmath>
+#include <gtest/gtest.h>
+
+using cartesian_controller_base::WrenchFilter;
+typedef WrenchFilter::Coefficients Coefficients;
+
+const double sample_rate = 1000.0;
+
+//! A wrench with different values on all axes
+ctrl::Vector6D wrench()
+{
+  ctrl::Vector6D w;
+  w << 10.0, -5.0, 2.5, 0.1, -0.2, 0.3;
+  return w;
+}
+
+/**
+ * @brief The largest amplitude of the output for a sine on all axes, once settled
+ *
+ * Use frequencies whose samples hit the sine's peaks, e.g. divisors of a
+ * quarter of the sample rate.
+ */
+double amplitude(WrenchFilter& filter, double frequency)
+{
+  const int settle = 2000;
+  const int samples = 2000;
+  double amplitude = 0.0;
+  for (int i = 0; i < settle + samples; ++i)
+  {
+    const double input = std::sin(2.0 * M_PI * frequency * i / sample_rate);
+    const ctrl::Vector6D& output = filter.filter(ctrl::Vector6D::Constant(input));
+    if (i >= settle)
+    {
+      amplitude = std::max(amplitude, output.cwiseAbs().maxCoeff());
+    }
+  }
+  return amplitude;
+}
+
+TEST(WrenchFilterTests, passThrough)
+{
+  WrenchFilter filter;
+  filter.setCoefficients(Coefficients::passThrough());
+  EXPECT_TRUE(filter.filter(wrench()).isApprox(wrench()));
+  EXPECT_TRUE(filter.filter(-wrench()).isApprox(-wrench()));
+}
+
+TEST(WrenchFilterTests, unitGainAtZeroFrequency)
+{
+  for (const Coefficients& c : {
+      Coefficients::lowPass(50.0, sample_rate, 0.7071),
+      Coefficients::lowPass(5.0, sample_rate, 2.0),
+      Coefficients::notch(50.0, sample_rate, 5.0),
+      Coefficients::notch(200.0, sample_rate, 0.5)})
+  {
+    EXPECT_NEAR(1.0, (c.b0 + c.b1 + c.b2) / (1.0 + c.a1 + c.a2), 1e-12);
+
+    WrenchFilter filter;
+    filter.setCoefficients(c);
+    for (int i = 0; i < 5000; ++i)
+    {
+      filter.filter(wrench());
+    }
+    EXPECT_TRUE(filter.output().isApprox(wrench(), 1e-9)) << filter.output().transpose();
+  }
+}
+
+TEST(WrenchFilterTests, lowPassAttenuation)
+{
+  WrenchFilter filter;
+  filter.setCoefficients(Coefficients::lowPass(50.0, sample_rate, 0.7071));
+  EXPECT_NEAR(1.0, amplitude(filter, 1.0), 0.01);
+  EXPECT_NEAR(std::sqrt(0.5), amplitude(filter, 50.0), 0.01);  // Butterworth: -3 dB at the cutoff
+  EXPECT_GT(0.05, amplitude(filter, 250.0));
+}
+
+TEST(WrenchFilterTests, notchAttenuation)
+{
+  WrenchFilter filter;
+  filter.setCoefficients(Coefficients::notch(50.0, sample_rate, 5.0));
+  EXPECT_GT(0.01, amplitude(filter, 50.0));
+  EXPECT_NEAR(1.0, amplitude(filter, 5.0), 0.01);
+  EXPECT_NEAR(1.0, amplitude(filter, 250.0), 0.01);
+}
+
+TEST(WrenchFilterTests, resetToSteadyState)
+{
+  for (const Coefficients& c : {
+      Coefficients::lowPass(50.0, sample_rate, 0.7071),
+      Coefficients::notch(50.0, sample_rate, 5.0)})
+  {
+    WrenchFilter filter;
+    filter.setCoefficients(c);
+    filter.reset(wrench());
+    EXPECT_TRUE(filter.output().isApprox(wrench()));
+    for (int i = 0; i < 10; ++i)
+    {
+      EXPECT_TRUE(filter.filter(wrench()).isApprox(wrench(), 1e-12)) << filter.output().transpose();
+    }
+  }
+}
+
+TEST(WrenchFilterTests, newCoefficientsContinueSteadily)
+{
+  WrenchFilter filter;
+  filter.setCoefficients(Coefficients::lowPass(50.0, sample_rate, 0.7071));
+  filter.reset(wrench());
+  filter.setCoefficients(Coefficients::notch(100.0, sample_rate, 2.0));
+  for (int i = 0; i < 10; ++i)
+  {
+    EXPECT_TRUE(filter.filter(wrench()).isApprox(wrench(), 1e-12)) << filter.output().transpose();
+  }
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -42,10 +42,20 @@
 
 // Project
 #include <cartesian_controller_base/cartesian_controller_base.h>
+#include <cartesian_controller_base/RingBuffer.h>
+#include <cartesian_controller_base/TripleBuffer.h>
+#include <cartesian_controller_base/WrenchFilter.h>
 
 // ROS
 #include <std_srvs/Trigger.h>
 
+// ros_controls
+#include <hardware_interface/force_torque_sensor_interface.h>
+#include <hardware_interface/robot_hw.h>
+
+// Other
+#include <atomic>
+
 // Dynamic reconfigure
 #include <dynamic_reconfigure/server.h>
 #include <cartesian_controller_base/ForwardDynamicsSolverConfig.h>
@@ -83,6 +93,18 @@ class CartesianForceController : public virtual cartesian_controller_base::Carte
   public:
     CartesianForceController();
 
+    /**
+     * @brief Get an optional force-torque sensor handle before initialization
+     *
+     * If the parameter \a ft_sensor_handle is set, the controller reads the
+     * sensor directly from the robot hardware's ForceTorqueSensorInterface
+     * in each control cycle instead of subscribing to \a ft_sensor_wrench.
+     */
+    bool initRequest(hardware_interface::RobotHW* robot_hw,
+                     ros::NodeHandle& root_nh,
+                     ros::NodeHandle& controller_nh,
+                     controller_interface::ControllerBase::ClaimedResources& claimed_resources);
+
     bool init(HardwareInterface* hw, ros::NodeHandle& nh);
 
     void starting(const ros::Time& time);
@@ -94,32 +116,128 @@ class CartesianForceController : public virtual cartesian_controller_base::Carte
     typedef cartesian_controller_base::CartesianControllerBase<HardwareInterface> Base;
 
   protected:
+    /**
+     * @brief Move the internal model such that the net force vanishes
+     *
+     * This is everything of update() except writing the commands to the
+     * hardware, so that it can run on an asynchronous worker.
+     *
+     * @param time The time of this control cycle
+     */
+    void computeJointMotion(const ros::Time& time);
+
+    /**
+     * @brief Filter all sensor wrenches that arrived since the last cycle
+     *
+     * Call this in every control cycle on the realtime thread, also between
+     * solver cycles and while an asynchronous solver step is busy.  Samples from the topic are fed to
+     * the filter in the order of arrival.  With a hardware handle, the filter
+     * gets one sample per call.
+     *
+     * @param time The time of the current control cycle
+     */
+    void updateFtSensorWrench(const ros::Time& time);
+
     /**
      * @brief Compute the net force out of target wrench and measured sensor wrench
      *
+     * Uses the filtered sensor wrench as of the start of the solver step.
+     * If that is older than \a ft_sensor_timeout, the robot holds still.
+     *
      * @return The remaining error wrench, given in robot base frame
      */
     ctrl::Vector6D        computeForceError();
+
+    /**
+     * The time since the newest sensor sample was measured, as of the last
+     * \ref updateFtSensorWrench.  Grows if the sensor stalls.
+     */
+    ros::Duration         m_ft_sensor_wrench_age;
+
+    //! The filtered sensor wrench for the solver step
+    ctrl::Vector6D        m_ft_sensor_wrench;
+
+    //! Whether \ref m_ft_sensor_wrench is older than the timeout
+    bool                  m_ft_sensor_wrench_stale;
+
+    //! Take the filtered wrench and its age for the next solver step
+    void snapshotFtSensorWrench();
+
     std::string           m_new_ft_sensor_ref;
-    void setFtSensorReferenceFrame(const std::string& new_ref);
+    int                   m_new_ft_sensor_ref_index;
 
-  private:
-    ctrl::Vector6D        compensateGravity();
+    /**
+     * @brief Express the sensor wrench in a new reference frame
+     *
+     * Only call this from init().  It must not run concurrently with
+     * update(), because it reads the frames through getKinematics() of the
+     * active solver.
+     */
+    void setFtSensorReferenceFrame(const std::string& new_ref);
 
     void targetWrenchCallback(const geometry_msgs::WrenchStamped& wrench);
     void ftSensorWrenchCallback(const geometry_msgs::WrenchStamped& wrench);
+
+  private:
+    /**
+     * @brief Compute this cycle's mapping of sensor wrenches into the base frame
+     *
+     * Sensor wrenches are measured in the sensor's frame and then displayed
+     * with the orientation of the base frame, but with the new sensor
+     * reference frame as reference point.  Both steps are fused into one
+     * 6x6 matrix \ref m_ft_sensor_to_base.  Gravity compensation and the
+     * taring offset are fused into one wrench \ref m_ft_sensor_offset,
+     * which is also expressed in the base frame.  Both use the kinematics
+     * of the current cycle.
+     */
+    void updateFtSensorTransform();
+
+    /**
+     * @brief Get the hardware handle's current wrench in the sensor's frame
+     */
+    ctrl::Vector6D        readFtSensorHandle();
+
     bool signalTaringCallback(std_srvs::Trigger::Request& req, std_srvs::Trigger::Response& res);
 
     ros::ServiceServer    m_signal_taring_server;
     ros::Subscriber       m_target_wrench_subscriber;
     ros::Subscriber       m_ft_sensor_wrench_subscriber;
-    ctrl::Vector6D        m_target_wrench;
-    ctrl::Vector6D        m_ft_sensor_wrench;
-    ctrl::Vector6D        m_weight_force;
+
+    struct FtSensorSample
+    {
+      ros::Time       stamp;
+      ctrl::Vector6D  wrench;  ///< In the sensor's frame
+    };
+
+    // Lock-free handoff of wrenches from the subscribers to the realtime loop.
+    // The ring keeps every sensor sample between two control cycles.  The
+    // latest sample alone restarts the filter in starting().
+    cartesian_controller_base::TripleBuffer<ctrl::Vector6D> m_target_wrench;
+    cartesian_controller_base::RingBuffer<FtSensorSample>   m_ft_sensor_samples;
+    cartesian_controller_base::TripleBuffer<FtSensorSample> m_ft_sensor_latest;
+
+    // Sensor wrench filtering in the realtime loop
+    typedef cartesian_controller_base::WrenchFilter::Coefficients FilterCoefficients;
+    cartesian_controller_base::WrenchFilter                     m_ft_sensor_filter;
+    cartesian_controller_base::TripleBuffer<FilterCoefficients> m_ft_sensor_filter_coefficients;
+    ros::Time             m_ft_sensor_stamp;  ///< Of the newest filtered sample
+    ros::Duration         m_ft_sensor_timeout;  ///< Zero disables the check
+
+    ctrl::Vector3D        m_weight_force;  ///< In base frame
     ctrl::Vector6D        m_grav_comp_during_taring;
     ctrl::Vector3D        m_center_of_mass;
     std::string           m_ft_sensor_ref_link;
-    KDL::Frame            m_ft_sensor_transform;
+    int                   m_ft_sensor_ref_link_index;
+    ctrl::Vector3D        m_ft_sensor_position;  ///< In the new sensor reference frame
+    std::atomic<bool>     m_taring_requested;
+
+    // Sensor wrench pipeline of the current cycle
+    ctrl::Matrix6D        m_ft_sensor_to_base;
+    ctrl::Vector6D        m_ft_sensor_offset;
+
+    // Optional direct sensor access through the hardware interface
+    hardware_interface::ForceTorqueSensorHandle m_ft_sensor_handle;
+    bool                  m_use_ft_sensor_handle;
 
     /**
      * Allow users to choose whether to specify their target wrenches in the
@@ -53,10 +53,45 @@ namespace cartesian_force_controller
 template <class HardwareInterface>
 CartesianForceController<HardwareInterface>::
 CartesianForceController()
-: Base::CartesianControllerBase(), m_hand_frame_control(true)
+: Base::CartesianControllerBase(), m_ft_sensor_wrench_stale(false),
+  m_taring_requested(false), m_use_ft_sensor_handle(false),
+  m_hand_frame_control(true)
 {
 }
 
+template <class HardwareInterface>
+bool CartesianForceController<HardwareInterface>::
+initRequest(hardware_interface::RobotHW* robot_hw,
+            ros::NodeHandle& root_nh,
+            ros::NodeHandle& controller_nh,
+            controller_interface::ControllerBase::ClaimedResources& claimed_resources)
+{
+  std::string ft_sensor_handle;
+  if (controller_nh.getParam("ft_sensor_handle",ft_sensor_handle))
+  {
+    hardware_interface::ForceTorqueSensorInterface* ft_sensor_interface =
+      robot_hw->get<hardware_interface::ForceTorqueSensorInterface>();
+    if (!ft_sensor_interface)
+    {
+      ROS_ERROR_STREAM(controller_nh.getNamespace() + "/ft_sensor_handle" << " is set, "
+                       << "but the robot hardware has no ForceTorqueSensorInterface");
+      return false;
+    }
+    try
+    {
+      m_ft_sensor_handle = ft_sensor_interface->getHandle(ft_sensor_handle);
+    }
+    catch (const hardware_interface::HardwareInterfaceException& ex)
+    {
+      ROS_ERROR_STREAM(ex.what());
+      return false;
+    }
+    m_use_ft_sensor_handle = true;
+  }
+
+  return Base::initRequest(robot_hw,root_nh,controller_nh,claimed_resources);
+}
+
 template <class HardwareInterface>
 bool CartesianForceController<HardwareInterface>::
 init(HardwareInterface* hw, ros::NodeHandle& nh)
@@ -77,13 +112,37 @@ init(HardwareInterface* hw, ros::NodeHandle& nh)
                                            << Base::m_end_effector_link);
     return false;
   }
+  m_ft_sensor_ref_link_index = Base::getLinkIndex(m_ft_sensor_ref_link);
+
+  // Preallocate space for all sensor samples between two control cycles
+  int ft_sensor_buffer_size = 100;
+  nh.param("ft_sensor_buffer_size",ft_sensor_buffer_size,ft_sensor_buffer_size);
+  if (ft_sensor_buffer_size <= 0)
+  {
+    ROS_ERROR_STREAM(nh.getNamespace() + "/ft_sensor_buffer_size" << " must be positive");
+    return false;
+  }
+  m_ft_sensor_samples.init(ft_sensor_buffer_size);
+
+  // Optionally hold still once the sensor goes silent
+  double ft_sensor_timeout = 0.0;
+  nh.param("ft_sensor_timeout",ft_sensor_timeout,ft_sensor_timeout);
+  if (ft_sensor_timeout < 0.0)
+  {
+    ROS_ERROR_STREAM(nh.getNamespace() + "/ft_sensor_timeout" << " must not be negative");
+    return false;
+  }
+  m_ft_sensor_timeout = ros::Duration(ft_sensor_timeout);
 
   // Make sure sensor wrenches are interpreted correctly
   setFtSensorReferenceFrame(Base::m_end_effector_link);
 
   m_signal_taring_server = nh.advertiseService("signal_taring",&CartesianForceController<HardwareInterface>::signalTaringCallback,this);
   m_target_wrench_subscriber = nh.subscribe("target_wrench",2,&CartesianForceController<HardwareInterface>::targetWrenchCallback,this);
-  m_ft_sensor_wrench_subscriber = nh.subscribe("ft_sensor_wrench",2,&CartesianForceController<HardwareInterface>::ftSensorWrenchCallback,this);
+  if (!m_use_ft_sensor_handle)
+  {
+    m_ft_sensor_wrench_subscriber = nh.subscribe("ft_sensor_wrench",ft_sensor_buffer_size,&CartesianForceController<HardwareInterface>::ftSensorWrenchCallback,this);
+  }
 
   // Initialize tool and gravity compensation
   std::map<std::string, double> gravity;
@@ -106,12 +165,14 @@ init(HardwareInterface* hw, ros::NodeHandle& nh)
   m_center_of_mass = ctrl::Vector3D(tool["com_x"],tool["com_y"],tool["com_z"]);
 
   // In base frame
-  m_weight_force.head<3>() = tool["mass"] * ctrl::Vector3D(gravity["x"],gravity["y"],gravity["z"]);
-  m_weight_force.tail<3>() = ctrl::Vector3D::Zero();  // Update in control cycle
-  m_grav_comp_during_taring = -m_weight_force;
+  m_weight_force = tool["mass"] * ctrl::Vector3D(gravity["x"],gravity["y"],gravity["z"]);
+  m_grav_comp_during_taring.head<3>() = -m_weight_force;
+  m_grav_comp_during_taring.tail<3>() = ctrl::Vector3D::Zero();
+  m_ft_sensor_to_base.setZero();
 
-  m_target_wrench.setZero();
-  m_ft_sensor_wrench.setZero();
+  m_target_wrench.initRT(ctrl::Vector6D::Zero());
+  m_ft_sensor_latest.initRT(FtSensorSample{ros::Time(), ctrl::Vector6D::Zero()});
+  m_ft_sensor_filter_coefficients.initRT(FilterCoefficients::passThrough());
 
   // Connect dynamic reconfigure and overwrite the default values with values
   // on the parameter server. This is done automatically if parameters with
@@ -124,6 +185,9 @@ init(HardwareInterface* hw, ros::NodeHandle& nh)
 
   m_dyn_conf_server->setCallback(m_callback_type);
 
+  Base::setSolverTask([this](const ros::Time& time){ computeJointMotion(time); });
+  Base::setSolverSnapshot([this](){ snapshotFtSensorWrench(); });
+
   return true;
 }
 
@@ -132,12 +196,35 @@ void CartesianForceController<HardwareInterface>::
 starting(const ros::Time& time)
 {
   Base::starting(time);
+
+  // Start the filter in steady state with the latest sample, so that older
+  // samples don't cause a transient.  Use the coefficients of dynamic
+  // reconfigure right away.
+  if (m_ft_sensor_filter_coefficients.hasNewData())
+  {
+    m_ft_sensor_filter.setCoefficients(*m_ft_sensor_filter_coefficients.readFromRT());
+  }
+  m_ft_sensor_samples.clear();
+  if (m_use_ft_sensor_handle)
+  {
+    m_ft_sensor_filter.reset(readFtSensorHandle());
+    m_ft_sensor_stamp = time;
+  }
+  else
+  {
+    const FtSensorSample& latest = *m_ft_sensor_latest.readFromRT();
+    m_ft_sensor_filter.reset(latest.wrench);
+    m_ft_sensor_stamp = latest.stamp;
+  }
+  m_ft_sensor_wrench_age = time - m_ft_sensor_stamp;
+  snapshotFtSensorWrench();
 }
 
 template <class HardwareInterface>
 void CartesianForceController<HardwareInterface>::
 stopping(const ros::Time& time)
 {
+  Base::stopping(time);
 }
 
 template <>
@@ -145,6 +232,7 @@ void CartesianForceController<hardware_interface::VelocityJointInterface>::
 stopping(const ros::Time& time)
 {
     // Stop drifting by sending zero joint velocities
+    Base::stopping(time);
     Base::computeJointControlCmds(ctrl::Vector6D::Zero(), ros::Duration(0));
     Base::writeJointControlCmds();
 }
@@ -152,9 +240,39 @@ stopping(const ros::Time& time)
 template <class HardwareInterface>
 void CartesianForceController<HardwareInterface>::
 update(const ros::Time& time, const ros::Duration& period)
+{
+  auto allocations = Base::trackAllocations();
+
+  // Filter every sensor sample on the realtime thread, also between solver
+  // cycles and while the asynchronous worker is busy
+  updateFtSensorWrench(time);
+
+  // Between solver cycles, only move on towards the last solution
+  if (Base::interpolateJointControlCmds())
+  {
+    return;
+  }
+
+  // Optionally solve on the asynchronous worker instead
+  if (Base::solveAsynchronously(time))
+  {
+    return;
+  }
+
+  computeJointMotion(time);
+
+  // Write final commands to the hardware interface
+  Base::writeJointControlCmds();
+}
+
+template <class HardwareInterface>
+void CartesianForceController<HardwareInterface>::
+computeJointMotion(const ros::Time& time)
 {
   // Synchronize the internal model and the real robot
-  Base::m_ik_solver->synchronizeJointPositions(Base::m_joint_handles);
+  Base::startStageTimer();
+  Base::synchronizeJointPositions();
+  Base::lapStageTimer(Base::SYNCHRONIZATION);
 
   // Control the robot motion in such a way that the resulting net force
   // vanishes.  The internal 'simulation time' is deliberately independent of
@@ -163,12 +281,48 @@ update(const ros::Time& time, const ros::Duration& period)
 
   // Compute the net force
   ctrl::Vector6D error = computeForceError();
+  Base::lapStageTimer(Base::ERROR_COMPUTATION);
 
   // Turn Cartesian error into joint motion
   Base::computeJointControlCmds(error,internal_period);
+}
 
-  // Write final commands to the hardware interface
-  Base::writeJointControlCmds();
+template <class HardwareInterface>
+void CartesianForceController<HardwareInterface>::
+updateFtSensorWrench(const ros::Time& time)
+{
+  if (m_ft_sensor_filter_coefficients.hasNewData())
+  {
+    m_ft_sensor_filter.setCoefficients(*m_ft_sensor_filter_coefficients.readFromRT());
+  }
+
+  if (m_use_ft_sensor_handle)
+  {
+    // The hardware provides one fresh sample per control cycle
+    m_ft_sensor_filter.filter(readFtSensorHandle());
+    m_ft_sensor_stamp = time;
+  }
+  else
+  {
+    // Samples that arrive meanwhile wait for the next cycle
+    for (size_t n = m_ft_sensor_samples.size(); n > 0; --n)
+    {
+      const FtSensorSample& sample = m_ft_sensor_samples[0];
+      m_ft_sensor_filter.filter(sample.wrench);
+      m_ft_sensor_stamp = sample.stamp;
+      m_ft_sensor_samples.pop();
+    }
+  }
+  m_ft_sensor_wrench_age = time - m_ft_sensor_stamp;
+}
+
+template <class HardwareInterface>
+void CartesianForceController<HardwareInterface>::
+snapshotFtSensorWrench()
+{
+  m_ft_sensor_wrench = m_ft_sensor_filter.output();
+  m_ft_sensor_wrench_stale =
+    !m_ft_sensor_timeout.isZero() && m_ft_sensor_wrench_age > m_ft_sensor_timeout;
 }
 
 template <class HardwareInterface>
@@ -178,17 +332,28 @@ computeForceError()
   ctrl::Vector6D target_wrench;
   if (m_hand_frame_control) // Assume end-effector frame by convention
   {
-    target_wrench = Base::displayInBaseLink(m_target_wrench,Base::m_end_effector_link);
+    target_wrench = Base::displayInBaseLink(*m_target_wrench.readFromRT(),Base::m_end_effector_link_index);
   }
   else // Default to robot base frame
   {
-    target_wrench = m_target_wrench;
+    target_wrench = *m_target_wrench.readFromRT();
   }
 
   // Superimpose target wrench and sensor wrench in base frame
-  return Base::displayInBaseLink(m_ft_sensor_wrench,m_new_ft_sensor_ref)
+  updateFtSensorTransform();
+  Base::m_feedback_wrench.noalias() = m_ft_sensor_to_base * m_ft_sensor_wrench;
+
+  // Don't keep reacting to the last wrench of a sensor that went silent
+  if (m_ft_sensor_wrench_stale)
+  {
+    ROS_WARN_STREAM_THROTTLE(3, "No sensor wrench within ft_sensor_timeout ("
+        << m_ft_sensor_timeout.toSec() << " s). Holding still");
+    return ctrl::Vector6D::Zero();
+  }
+
+  return Base::m_feedback_wrench
     + target_wrench
-    + compensateGravity();
+    + m_ft_sensor_offset;
 }
 
 template <class HardwareInterface>
@@ -198,97 +363,115 @@ setFtSensorReferenceFrame(const std::string& new_ref)
   // Compute static transform from the force torque sensor to the new reference
   // frame of interest.
   m_new_ft_sensor_ref = new_ref;
+  m_new_ft_sensor_ref_index = Base::getLinkIndex(m_new_ft_sensor_ref);
 
   // Joint positions should cancel out, i.e. it doesn't matter as long as they
   // are the same for both transformations.
-  KDL::JntArray jnts(Base::m_ik_solver->getPositions());
-
-  KDL::Frame sensor_ref;
-  Base::m_forward_kinematics_solver->JntToCart(
-      jnts,
-      sensor_ref,
-      m_ft_sensor_ref_link);
+  const cartesian_controller_base::KinematicsCache& kinematics =
+    Base::m_ik_solver->getKinematics();
 
-  KDL::Frame new_sensor_ref;
-  Base::m_forward_kinematics_solver->JntToCart(
-      jnts,
-      new_sensor_ref,
-      m_new_ft_sensor_ref);
+  const KDL::Frame& sensor_ref = kinematics.getSegmentFrame(m_ft_sensor_ref_link_index);
+  const KDL::Frame& new_sensor_ref = kinematics.getSegmentFrame(m_new_ft_sensor_ref_index);
 
-  m_ft_sensor_transform = new_sensor_ref.Inverse() * sensor_ref;
+  const KDL::Vector p = (new_sensor_ref.Inverse() * sensor_ref).p;
+  m_ft_sensor_position = ctrl::Vector3D(p.x(), p.y(), p.z());
 }
 
 template <class HardwareInterface>
-ctrl::Vector6D CartesianForceController<HardwareInterface>::
-compensateGravity()
+void CartesianForceController<HardwareInterface>::
+updateFtSensorTransform()
 {
-  ctrl::Vector6D compensating_force = ctrl::Vector6D::Zero();
-
-  // Compute actual gravity effects in sensor frame
-  ctrl::Vector6D tmp = Base::displayInTipLink(m_weight_force,m_ft_sensor_ref_link);
-  tmp.tail<3>() = m_center_of_mass.cross(tmp.head<3>()); // M = r x F
-
-  // Display in base link
-  m_weight_force = Base::displayInBaseLink(tmp,m_ft_sensor_ref_link);
-
-  // Add actual gravity compensation
-  compensating_force -= m_weight_force;
-
-  // Remove deprecated terms from moment of taring
-  compensating_force -= m_grav_comp_during_taring;
+  const cartesian_controller_base::KinematicsCache& kinematics =
+    Base::m_ik_solver->getKinematics();
+  const ctrl::RotationMap R_sensor(kinematics.getSegmentFrame(m_ft_sensor_ref_link_index).M.data);
+  const ctrl::RotationMap R_ref(kinematics.getSegmentFrame(m_new_ft_sensor_ref_index).M.data);
+
+  // Lever from the new reference point to the sensor, in base orientation
+  const ctrl::Vector3D p = R_ref * m_ft_sensor_position;
+  ctrl::Matrix3D p_cross;
+  p_cross <<
+    0.0,    -p.z(),  p.y(),
+    p.z(),   0.0,   -p.x(),
+    -p.y(),  p.x(),  0.0;
+
+  // \f$ f = R f_s, \quad \tau = R \tau_s + p \times R f_s \f$
+  m_ft_sensor_to_base.topLeftCorner<3,3>() = R_sensor;
+  m_ft_sensor_to_base.bottomLeftCorner<3,3>().noalias() = p_cross * R_sensor;
+  m_ft_sensor_to_base.bottomRightCorner<3,3>() = R_sensor;
+
+  // The tool's weight force and its moment around the sensor (M = r x F),
+  // both in base frame
+  ctrl::Vector6D weight;
+  weight.head<3>() = m_weight_force;
+  weight.tail<3>() = (R_sensor * m_center_of_mass).cross(m_weight_force);
+
+  // Tare on request. Taring the sensor is like adding a virtual force that
+  // exactly compensates the current weight force.
+  if (m_taring_requested.exchange(false))
+  {
+    m_grav_comp_during_taring = -weight;
+  }
 
-  return compensating_force;
+  // Compensate the actual gravity and remove deprecated terms from moment of taring
+  m_ft_sensor_offset = -weight - m_grav_comp_during_taring;
 }
 
 template <class HardwareInterface>
-void CartesianForceController<HardwareInterface>::
-targetWrenchCallback(const geometry_msgs::WrenchStamped& wrench)
+ctrl::Vector6D CartesianForceController<HardwareInterface>::
+readFtSensorHandle()
 {
-  m_target_wrench[0] = wrench.wrench.force.x;
-  m_target_wrench[1] = wrench.wrench.force.y;
-  m_target_wrench[2] = wrench.wrench.force.z;
-  m_target_wrench[3] = wrench.wrench.torque.x;
-  m_target_wrench[4] = wrench.wrench.torque.y;
-  m_target_wrench[5] = wrench.wrench.torque.z;
+  ctrl::Vector6D ft_sensor_wrench = ctrl::Vector6D::Zero();
+  if (const double* force = m_ft_sensor_handle.getForce())
+  {
+    ft_sensor_wrench.head<3>() = Eigen::Map<const ctrl::Vector3D>(force);
+  }
+  if (const double* torque = m_ft_sensor_handle.getTorque())
+  {
+    ft_sensor_wrench.tail<3>() = Eigen::Map<const ctrl::Vector3D>(torque);
+  }
+  return ft_sensor_wrench;
 }
 
 template <class HardwareInterface>
 void CartesianForceController<HardwareInterface>::
-ftSensorWrenchCallback(const geometry_msgs::WrenchStamped& wrench)
+targetWrenchCallback(const geometry_msgs::WrenchStamped& wrench)
 {
-  KDL::Wrench tmp;
+  ctrl::Vector6D tmp;
   tmp[0] = wrench.wrench.force.x;
   tmp[1] = wrench.wrench.force.y;
   tmp[2] = wrench.wrench.force.z;
   tmp[3] = wrench.wrench.torque.x;
   tmp[4] = wrench.wrench.torque.y;
   tmp[5] = wrench.wrench.torque.z;
+  m_target_wrench.writeFromNonRT(tmp);
+}
 
-  // Compute how the measured wrench appears in the frame of interest.
-  tmp = m_ft_sensor_transform * tmp;
-
-  m_ft_sensor_wrench[0] = tmp[0];
-  m_ft_sensor_wrench[1] = tmp[1];
-  m_ft_sensor_wrench[2] = tmp[2];
-  m_ft_sensor_wrench[3] = tmp[3];
-  m_ft_sensor_wrench[4] = tmp[4];
-  m_ft_sensor_wrench[5] = tmp[5];
+template <class HardwareInterface>
+void CartesianForceController<HardwareInterface>::
+ftSensorWrenchCallback(const geometry_msgs::WrenchStamped& wrench)
+{
+  // The realtime loop filters this and displays it in the frame of interest
+  FtSensorSample sample;
+  sample.stamp = wrench.header.stamp.isZero() ? ros::Time::now() : wrench.header.stamp;
+  sample.wrench[0] = wrench.wrench.force.x;
+  sample.wrench[1] = wrench.wrench.force.y;
+  sample.wrench[2] = wrench.wrench.force.z;
+  sample.wrench[3] = wrench.wrench.torque.x;
+  sample.wrench[4] = wrench.wrench.torque.y;
+  sample.wrench[5] = wrench.wrench.torque.z;
+
+  // Drop the sample if the realtime loop doesn't keep up
+  m_ft_sensor_samples.push(sample);
+  m_ft_sensor_latest.writeFromNonRT(sample);
 }
 
 template <class HardwareInterface>
 bool CartesianForceController<HardwareInterface>::
 signalTaringCallback(std_srvs::Trigger::Request& req, std_srvs::Trigger::Response& res)
 {
-  // Compute current gravity effects in sensor frame
-  ctrl::Vector6D tmp = Base::displayInTipLink(m_weight_force,m_ft_sensor_ref_link);
-  tmp.tail<3>() = m_center_of_mass.cross(tmp.head<3>()); // M = r x F
-
-  // Taring the sensor is like adding a virtual force that exactly compensates
-  // the weight force.
-  tmp = -tmp;
-
-  // Display in base link
-  m_grav_comp_during_taring = Base::displayInBaseLink(tmp,m_ft_sensor_ref_link);
+  // The realtime loop computes the according compensation in its next cycle
+  // with its own kinematics. We only signal that here.
+  m_taring_requested = true;
 
   res.message = "Got it.";
   res.success = true;
@@ -300,6 +483,23 @@ void CartesianForceController<HardwareInterface>::dynamicReconfigureCallback(Con
                                                                              uint32_t level)
 {
   m_hand_frame_control = config.hand_frame_control;
+
+  // Design the filter here, so that the realtime loop only swaps coefficients
+  if (config.ft_sensor_filter == Config::CartesianForceController_none)
+  {
+    m_ft_sensor_filter_coefficients.writeFromNonRT(FilterCoefficients::passThrough());
+    return;
+  }
+  if (config.ft_sensor_filter_frequency >= config.ft_sensor_rate / 2.0)
+  {
+    ROS_ERROR_STREAM("ft_sensor_filter_frequency must be below half the ft_sensor_rate. "
+                     << "Keeping the previous filter.");
+    return;
+  }
+  m_ft_sensor_filter_coefficients.writeFromNonRT(
+    config.ft_sensor_filter == Config::CartesianForceController_low_pass
+    ? FilterCoefficients::lowPass(config.ft_sensor_filter_frequency, config.ft_sensor_rate, config.ft_sensor_filter_q)
+    : FilterCoefficients::notch(config.ft_sensor_filter_frequency, config.ft_sensor_rate, config.ft_sensor_filter_q));
 }
 
 }
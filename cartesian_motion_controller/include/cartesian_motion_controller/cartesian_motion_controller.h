@@ -42,10 +42,19 @@
 
 // Project
 #include <cartesian_controller_base/cartesian_controller_base.h>
+#include <cartesian_controller_base/TripleBuffer.h>
+#include <cartesian_controller_base/RingBuffer.h>
+#include <cartesian_controller_base/TargetRegistry.h>
 
 // ROS
 #include <kdl/frames.hpp>
 #include <geometry_msgs/PoseStamped.h>
+#include <geometry_msgs/TwistStamped.h>
+#include <nav_msgs/Path.h>
+
+// Other
+#include <Eigen/Geometry>
+#include <atomic>
 
 namespace cartesian_motion_controller
 {
@@ -71,6 +80,13 @@ namespace cartesian_motion_controller
  * this controller to a fast Inverse Kinematics solver, with setting
  * qualitatively high P gains. Note, however, that this requires
  * high-frequently published targets to avoid jumps on joint level.
+ * Alternatively, users stream batches of time-stamped targets as \a
+ * nav_msgs::Path messages, which the controller interpolates in each
+ * control cycle.
+ *
+ * Teleoperation and visual servoing may command \a geometry_msgs::TwistStamped
+ * messages instead, which the controller integrates into its target pose in
+ * each control cycle.
  *
  * @tparam HardwareInterface The interface to support. Either PositionJointInterface or VelocityJointInterface
  */
@@ -92,6 +108,30 @@ class CartesianMotionController : public virtual cartesian_controller_base::Cart
     typedef cartesian_controller_base::CartesianControllerBase<HardwareInterface> Base;
 
   protected:
+    /**
+     * @brief Move the internal model towards the current target
+     *
+     * This is everything of update() except writing the commands to the
+     * hardware, so that controllers can compute several chains before
+     * writing all of them, or hand this to an asynchronous worker.
+     *
+     * @param time The time of this control cycle
+     */
+    void computeJointMotion(const ros::Time& time);
+
+    /**
+     * @brief Set \ref m_target_frame for this control cycle
+     *
+     * Takes the most recent target pose, or interpolates the streamed targets
+     * at the given time.  Streamed targets take precedence while they last,
+     * and their last sample holds until new streamed or other targets arrive.
+     * Commanded twists move the target on from there.
+     * Call this once per control cycle before \ref computeMotionError.
+     *
+     * @param time The time of this control cycle
+     */
+    void updateTargetFrame(const ros::Time& time);
+
     /**
      * @brief Compute the offset between a target pose and the current end effector pose
      *
@@ -108,10 +148,67 @@ class CartesianMotionController : public virtual cartesian_controller_base::Cart
     KDL::Frame      m_target_frame;
     KDL::Frame      m_current_frame;
 
+    //! Lock-free handoff of new targets to the realtime loop
+    cartesian_controller_base::TripleBuffer<KDL::Frame> m_target_frame_buffer;
+
+    //! Targets from a co-located controller, bypassing the target topic. Optional.
+    std::shared_ptr<cartesian_controller_base::TargetChannel> m_target_channel;
+
     void targetFrameCallback(const geometry_msgs::PoseStamped& pose);
+    void targetPathCallback(const nav_msgs::Path& path);
+    void targetTwistCallback(const geometry_msgs::TwistStamped& twist);
 
     ros::Subscriber m_target_frame_subscr;
     std::string     m_target_frame_topic;
+
+  private:
+    //! A streamed target pose
+    struct TargetSample
+    {
+      double              time;  ///< seconds
+      Eigen::Vector3d     position;
+      Eigen::Quaterniond  orientation;
+    };
+
+    //! A commanded twist
+    struct TargetTwist
+    {
+      KDL::Twist  twist;
+      bool        in_tool_frame;  ///< Otherwise in the robot base link
+    };
+
+    /**
+     * @brief Move \ref m_target_frame with the commanded twist
+     *
+     * The twist drops to zero if no new one arrives within the timeout.
+     *
+     * @param time The time of this control cycle
+     */
+    void integrateTargetTwist(const ros::Time& time);
+
+    //! Future targets, handed over lock-free to the realtime loop
+    cartesian_controller_base::RingBuffer<TargetSample> m_target_stream;
+    double m_last_streamed_time;  ///< Owned by the subscriber
+    std::atomic<bool> m_stream_restarted;  ///< Tells the subscriber to accept any time stamp again
+
+    // The segment between the last passed sample and the next one in the stream
+    TargetSample    m_segment_start;
+    Eigen::Vector3d m_segment_start_tangent;
+    Eigen::Vector3d m_segment_end_tangent;
+    bool            m_streaming;
+    bool            m_segment_ready;
+
+    ros::Subscriber m_target_path_subscr;
+
+    // Commanded twists, handed over lock-free to the realtime loop
+    cartesian_controller_base::TripleBuffer<TargetTwist> m_target_twist_buffer;
+    TargetTwist     m_target_twist;
+    ros::Duration   m_target_twist_timeout;
+    ros::Time       m_target_twist_received;  ///< Control cycle of the last new twist
+    ros::Time       m_target_twist_integrated;
+    bool            m_twisting;
+
+    ros::Subscriber m_target_twist_subscr;
 };
 
 }
@@ -52,7 +52,9 @@ namespace cartesian_motion_controller
 template <class HardwareInterface>
 CartesianMotionController<HardwareInterface>::
 CartesianMotionController()
-: Base::CartesianControllerBase()
+: Base::CartesianControllerBase(),
+  m_last_streamed_time(0.0), m_stream_restarted(false), m_streaming(false), m_segment_ready(false),
+  m_twisting(false)
 {
 }
 
@@ -77,6 +79,45 @@ init(HardwareInterface* hw, ros::NodeHandle& nh)
       &CartesianMotionController<HardwareInterface>::targetFrameCallback,
       this);
 
+  // Optionally take targets directly from a co-located controller
+  bool synchronous_targets = false;
+  nh.getParam("synchronous_targets", synchronous_targets);
+  if (synchronous_targets)
+  {
+    m_target_channel = cartesian_controller_base::TargetRegistry::getReader(
+        nh.resolveName(m_target_frame_topic), Base::m_robot_base_link);
+    if (!m_target_channel)
+    {
+      return false;
+    }
+  }
+
+  // Streamed targets
+  std::string target_path_topic = "target_path";
+  int target_path_buffer_size = 1000;
+  nh.getParam("target_path_topic", target_path_topic);
+  nh.getParam("target_path_buffer_size", target_path_buffer_size);
+  m_target_stream.init(std::max(target_path_buffer_size, 2));
+  m_target_path_subscr = nh.subscribe(
+      target_path_topic,
+      3,
+      &CartesianMotionController<HardwareInterface>::targetPathCallback,
+      this);
+
+  // Commanded twists and how long they last without a new one
+  std::string target_twist_topic = "target_twist";
+  double target_twist_timeout = 0.1;
+  nh.getParam("target_twist_topic", target_twist_topic);
+  nh.getParam("target_twist_timeout", target_twist_timeout);
+  m_target_twist_timeout = ros::Duration(std::max(target_twist_timeout, 0.0));
+  m_target_twist_subscr = nh.subscribe(
+      target_twist_topic,
+      3,
+      &CartesianMotionController<HardwareInterface>::targetTwistCallback,
+      this);
+
+  Base::setSolverTask([this](const ros::Time& time){ computeJointMotion(time); });
+
   return true;
 }
 
@@ -90,12 +131,23 @@ starting(const ros::Time& time)
 
   // Start where we are
   m_target_frame = m_current_frame;
+  m_target_frame_buffer.initRT(m_target_frame);
+  if (m_target_channel)
+  {
+    m_target_channel->initRT(m_target_frame);
+  }
+  m_target_stream.clear();
+  m_stream_restarted = true;
+  m_streaming = false;
+  m_target_twist_buffer.initRT(TargetTwist{KDL::Twist::Zero(), false});
+  m_twisting = false;
 }
 
 template <class HardwareInterface>
 void CartesianMotionController<HardwareInterface>::
 stopping(const ros::Time& time)
 {
+  Base::stopping(time);
 }
 
 template <>
@@ -103,6 +155,7 @@ void CartesianMotionController<hardware_interface::VelocityJointInterface>::
 stopping(const ros::Time& time)
 {
     // Stop drifting by sending zero joint velocities
+    Base::stopping(time);
     Base::computeJointControlCmds(ctrl::Vector6D::Zero(), ros::Duration(0));
     Base::writeJointControlCmds();
 }
@@ -110,14 +163,42 @@ stopping(const ros::Time& time)
 template <class HardwareInterface>
 void CartesianMotionController<HardwareInterface>::
 update(const ros::Time& time, const ros::Duration& period)
+{
+  auto allocations = Base::trackAllocations();
+
+  // Between solver cycles, only move on towards the last solution
+  if (Base::interpolateJointControlCmds())
+  {
+    return;
+  }
+
+  // Optionally solve on the asynchronous worker instead
+  if (Base::solveAsynchronously(time))
+  {
+    return;
+  }
+
+  computeJointMotion(time);
+
+  // Write final commands to the hardware interface
+  Base::writeJointControlCmds();
+}
+
+template <class HardwareInterface>
+void CartesianMotionController<HardwareInterface>::
+computeJointMotion(const ros::Time& time)
 {
   // Synchronize the internal model and the real robot
-  Base::m_ik_solver->synchronizeJointPositions(Base::m_joint_handles);
+  Base::startStageTimer();
+  Base::synchronizeJointPositions();
+  updateTargetFrame(time);
+  Base::lapStageTimer(Base::SYNCHRONIZATION);
 
   // Forward Dynamics turns the search for the according joint motion into a
   // control process. So, we control the internal model until we meet the
   // Cartesian target motion. This internal control needs some simulation time
   // steps.
+  Base::beginIterations();
   for (int i = 0; i < Base::m_iterations; ++i)
   {
     // The internal 'simulation time' is deliberately independent of the outer
@@ -126,13 +207,16 @@ update(const ros::Time& time, const ros::Duration& period)
 
     // Compute the motion error = target - current.
     ctrl::Vector6D error = computeMotionError();
+    Base::lapStageTimer(Base::ERROR_COMPUTATION);
+    if (!Base::continueIterations(error))
+    {
+      break;
+    }
 
     // Turn Cartesian error into joint motion
     Base::computeJointControlCmds(error,internal_period);
   }
-
-  // Write final commands to the hardware interface
-  Base::writeJointControlCmds();
+  Base::endIterations();
 }
 
 template <class HardwareInterface>
@@ -179,6 +263,124 @@ computeMotionError()
   return error;
 }
 
+template <class HardwareInterface>
+void CartesianMotionController<HardwareInterface>::
+updateTargetFrame(const ros::Time& time)
+{
+  bool new_target = false;
+  if (m_target_frame_buffer.hasNewData())
+  {
+    m_target_frame = *m_target_frame_buffer.readFromRT();
+    new_target = true;
+  }
+  if (m_target_channel && m_target_channel->hasNewData())
+  {
+    m_target_frame = *m_target_channel->readFromRT();
+    new_target = true;
+  }
+  integrateTargetTwist(time);
+  new_target = new_target || m_twisting;
+
+  // Pass the streamed samples that are due.  Streams start and end at rest.
+  const double now = time.toSec();
+  while (m_target_stream.size() > 0 && m_target_stream[0].time <= now)
+  {
+    m_segment_start_tangent =
+      m_streaming && m_segment_ready ? m_segment_end_tangent : Eigen::Vector3d::Zero();
+    m_segment_start = m_target_stream[0];
+    m_target_stream.pop();
+    m_streaming = true;
+    m_segment_ready = false;
+  }
+  if (!m_streaming)
+  {
+    return;
+  }
+
+  const TargetSample& start = m_segment_start;
+  if (m_target_stream.size() == 0)
+  {
+    // The stream ran dry.  Other targets take over from here.
+    if (new_target)
+    {
+      m_streaming = false;
+      return;
+    }
+
+    // Otherwise hold the last sample at rest.  The next one that arrives
+    // continues the stream from here instead of jumping to it.
+    m_target_frame = KDL::Frame(
+        KDL::Rotation::Quaternion(
+          start.orientation.x(), start.orientation.y(), start.orientation.z(), start.orientation.w()),
+        KDL::Vector(start.position.x(), start.position.y(), start.position.z()));
+    m_segment_start.time = now;
+    m_segment_start_tangent = Eigen::Vector3d::Zero();
+    m_segment_ready = false;
+    return;
+  }
+  const TargetSample& end = m_target_stream[0];
+
+  // Fix the end tangent once per segment, so that samples that arrive late
+  // don't bend a segment that is already on its way.
+  if (!m_segment_ready)
+  {
+    m_segment_end_tangent = m_target_stream.size() > 1 ?
+      Eigen::Vector3d((m_target_stream[1].position - start.position) / (m_target_stream[1].time - start.time)) :
+      Eigen::Vector3d::Zero();
+    m_segment_ready = true;
+  }
+
+  // Cubic Hermite spline for the position, SLERP for the orientation
+  const double h = end.time - start.time;
+  const double s = (now - start.time) / h;
+  const double s2 = s * s;
+  const double s3 = s2 * s;
+  const Eigen::Vector3d position =
+    (2 * s3 - 3 * s2 + 1) * start.position +
+    (s3 - 2 * s2 + s) * h * m_segment_start_tangent +
+    (-2 * s3 + 3 * s2) * end.position +
+    (s3 - s2) * h * m_segment_end_tangent;
+  const Eigen::Quaterniond orientation = start.orientation.slerp(s, end.orientation);
+
+  m_target_frame = KDL::Frame(
+      KDL::Rotation::Quaternion(orientation.x(), orientation.y(), orientation.z(), orientation.w()),
+      KDL::Vector(position.x(), position.y(), position.z()));
+}
+
+template <class HardwareInterface>
+void CartesianMotionController<HardwareInterface>::
+integrateTargetTwist(const ros::Time& time)
+{
+  if (m_target_twist_buffer.hasNewData())
+  {
+    m_target_twist = *m_target_twist_buffer.readFromRT();
+    m_target_twist_received = time;
+    if (!m_twisting)
+    {
+      m_target_twist_integrated = time;  // Start from here
+      m_twisting = true;
+    }
+  }
+  if (!m_twisting)
+  {
+    return;
+  }
+
+  // Stop if the commands stop, e.g. when the teleoperation node dies
+  if (time - m_target_twist_received > m_target_twist_timeout)
+  {
+    m_twisting = false;
+    return;
+  }
+
+  const double dt = (time - m_target_twist_integrated).toSec();
+  m_target_twist_integrated = time;
+  const KDL::Twist twist = m_target_twist.in_tool_frame ?
+    m_target_frame.M * m_target_twist.twist :
+    m_target_twist.twist;
+  m_target_frame = KDL::addDelta(m_target_frame, twist, dt);
+}
+
 template <class HardwareInterface>
 void CartesianMotionController<HardwareInterface>::
 targetFrameCallback(const geometry_msgs::PoseStamped& target)
@@ -191,7 +393,7 @@ targetFrameCallback(const geometry_msgs::PoseStamped& target)
     return;
   }
 
-  m_target_frame = KDL::Frame(
+  m_target_frame_buffer.writeFromNonRT(KDL::Frame(
       KDL::Rotation::Quaternion(
         target.pose.orientation.x,
         target.pose.orientation.y,
@@ -200,7 +402,84 @@ targetFrameCallback(const geometry_msgs::PoseStamped& target)
       KDL::Vector(
         target.pose.position.x,
         target.pose.position.y,
-        target.pose.position.z));
+        target.pose.position.z)));
+}
+
+template <class HardwareInterface>
+void CartesianMotionController<HardwareInterface>::
+targetPathCallback(const nav_msgs::Path& path)
+{
+  for (const auto& pose : path.poses)
+  {
+    const std::string& frame_id =
+      pose.header.frame_id.empty() ? path.header.frame_id : pose.header.frame_id;
+    if (frame_id != Base::m_robot_base_link)
+    {
+      ROS_WARN_STREAM_THROTTLE(3, "Got target path in wrong reference frame. Expected: "
+          << Base::m_robot_base_link << " but got "
+          << frame_id);
+      return;
+    }
+  }
+
+  // Streams of an earlier start may have had later time stamps
+  if (m_stream_restarted.exchange(false))
+  {
+    m_last_streamed_time = 0.0;
+  }
+
+  for (const auto& pose : path.poses)
+  {
+    TargetSample sample;
+    sample.time = pose.header.stamp.toSec();
+    if (sample.time <= m_last_streamed_time)
+    {
+      ROS_WARN_STREAM_THROTTLE(3, "Dropping streamed target poses with non-increasing time stamps");
+      continue;
+    }
+    sample.position = Eigen::Vector3d(
+        pose.pose.position.x,
+        pose.pose.position.y,
+        pose.pose.position.z);
+    sample.orientation = Eigen::Quaterniond(
+        pose.pose.orientation.w,
+        pose.pose.orientation.x,
+        pose.pose.orientation.y,
+        pose.pose.orientation.z).normalized();
+
+    if (!m_target_stream.push(sample))
+    {
+      ROS_WARN_STREAM_THROTTLE(3, "Target path buffer is full. Dropping streamed target poses");
+      return;
+    }
+    m_last_streamed_time = sample.time;
+  }
+}
+
+template <class HardwareInterface>
+void CartesianMotionController<HardwareInterface>::
+targetTwistCallback(const geometry_msgs::TwistStamped& twist)
+{
+  const bool in_tool_frame = twist.header.frame_id == Base::m_end_effector_link;
+  if (!in_tool_frame && twist.header.frame_id != Base::m_robot_base_link)
+  {
+    ROS_WARN_STREAM_THROTTLE(3, "Got target twist in wrong reference frame. Expected: "
+        << Base::m_robot_base_link << " or " << Base::m_end_effector_link << " but got "
+        << twist.header.frame_id);
+    return;
+  }
+
+  m_target_twist_buffer.writeFromNonRT(TargetTwist{
+      KDL::Twist(
+        KDL::Vector(
+          twist.twist.linear.x,
+          twist.twist.linear.y,
+          twist.twist.linear.z),
+        KDL::Vector(
+          twist.twist.angular.x,
+          twist.twist.angular.y,
+          twist.twist.angular.z)),
+      in_tool_frame});
 }
 
 } // namespace
@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    multi_chain_motion_controller.h
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef MULTI_CHAIN_MOTION_CONTROLLER_H_INCLUDED
+#define MULTI_CHAIN_MOTION_CONTROLLER_H_INCLUDED
+
+// Project
+#include <cartesian_motion_controller/cartesian_motion_controller.h>
+#include <cartesian_controller_base/WorkerPool.h>
+
+// ros_controls
+#include <controller_interface/controller.h>
+
+// Other
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cartesian_motion_controller
+{
+
+/**
+ * @brief A ROS-control controller for Cartesian motion on several chains at once
+ *
+ * This controller drives several kinematic chains of one robot, such as the
+ * arms of a dual-arm system, within one controller instance.  Each chain
+ * behaves like its own \ref CartesianMotionController with its own target
+ * topic, solver and gains, configured in a sub-namespace of this controller.
+ *
+ * In contrast to loading one controller per chain, the robot description is
+ * parsed only once and the chains are computed in parallel on worker threads.
+ * All chains finish their computation before any commands are written to the
+ * hardware.
+ *
+ * @tparam HardwareInterface The interface to support. Either PositionJointInterface or VelocityJointInterface
+ */
+template <class HardwareInterface>
+class MultiChainMotionController : public controller_interface::Controller<HardwareInterface>
+{
+  public:
+    MultiChainMotionController();
+
+    bool init(HardwareInterface* hw, ros::NodeHandle& nh);
+
+    void starting(const ros::Time& time);
+
+    void stopping(const ros::Time& time);
+
+    void update(const ros::Time& time, const ros::Duration& period);
+
+  protected:
+    /**
+     * @brief One motion controlled chain
+     *
+     * Exposes the two halves of the motion controller's update(), its
+     * targets, where it is and its allocation tracking.
+     */
+    class Chain : public CartesianMotionController<HardwareInterface>
+    {
+      public:
+        typedef cartesian_controller_base::CartesianControllerBase<HardwareInterface> Base;
+
+        using CartesianMotionController<HardwareInterface>::computeJointMotion;
+        using CartesianMotionController<HardwareInterface>::targetFrameCallback;
+        using Base::writeJointControlCmds;
+        using Base::interpolateJointControlCmds;
+        using Base::trackAllocations;
+        using Base::getAllocationTracker;
+        using Base::resetAllocationTrackers;
+
+        const KDL::Frame& getEndEffectorPose() const { return this->m_ik_solver->getEndEffectorPose(); }
+
+        const std::string& getRobotBaseLink() const { return this->m_robot_base_link; }
+    };
+
+    //! Each chain counts the allocations of its share of update(), also on the workers
+    std::vector<std::unique_ptr<Chain> > m_chains;
+
+  private:
+    std::vector<char> m_solving;  ///< Per chain, whether it solves in this cycle
+    ros::Time m_time;  ///< Of the current control cycle
+    cartesian_controller_base::WorkerPool m_worker_pool;
+};
+
+}
+
+#include <cartesian_motion_controller/multi_chain_motion_controller.hpp>
+
+#endif
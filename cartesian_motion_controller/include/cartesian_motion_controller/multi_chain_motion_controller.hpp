@@ -0,0 +1,174 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright 2019 FZI Research Center for Information Technology
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+/*!\file    multi_chain_motion_controller.hpp
+ *
+ * \date    2026/10/14
+ *
+ */
+//-----------------------------------------------------------------------------
+
+#ifndef MULTI_CHAIN_MOTION_CONTROLLER_HPP_INCLUDED
+#define MULTI_CHAIN_MOTION_CONTROLLER_HPP_INCLUDED
+
+// Project
+#include <cartesian_motion_controller/multi_chain_motion_controller.h>
+
+// Other
+#include <set>
+
+namespace cartesian_motion_controller
+{
+
+template <class HardwareInterface>
+MultiChainMotionController<HardwareInterface>::
+MultiChainMotionController()
+{
+}
+
+template <class HardwareInterface>
+bool MultiChainMotionController<HardwareInterface>::
+init(HardwareInterface* hw, ros::NodeHandle& nh)
+{
+  std::vector<std::string> chain_names;
+  if (!nh.getParam("chains", chain_names) || chain_names.empty())
+  {
+    ROS_ERROR_STREAM("Failed to load " << nh.getNamespace() + "/chains" << " from parameter server");
+    return false;
+  }
+
+  // All chains share the parsed robot model through the registry and the
+  // solver plugin loader.
+  std::shared_ptr<pluginlib::ClassLoader<cartesian_controller_base::IKSolver> > solver_loader(
+      new pluginlib::ClassLoader<cartesian_controller_base::IKSolver>(
+        "cartesian_controller_base", "cartesian_controller_base::IKSolver"));
+
+  // Each chain is configured in its own namespace
+  std::set<std::string> joints;
+  for (const std::string& name : chain_names)
+  {
+    ros::NodeHandle chain_nh(nh, name);
+    std::vector<std::string> chain_joints;
+    chain_nh.getParam("joints", chain_joints);
+    for (const std::string& joint : chain_joints)
+    {
+      if (!joints.insert(joint).second)
+      {
+        ROS_ERROR_STREAM("Joint " << joint << " is part of more than one chain");
+        return false;
+      }
+    }
+
+    m_chains.emplace_back(new Chain());
+    m_chains.back()->setSolverLoader(solver_loader);
+    if (!m_chains.back()->init(hw, chain_nh))
+    {
+      ROS_ERROR_STREAM("Failed to initialize chain " << name);
+      return false;
+    }
+  }
+
+  // One task per chain.  Optionally pin the workers to CPU cores.
+  std::vector<std::function<void()> > tasks;
+  m_solving.resize(m_chains.size());
+  for (size_t i = 0; i < m_chains.size(); ++i)
+  {
+    Chain* c = m_chains[i].get();
+    tasks.push_back([this, c, i](){
+      auto allocations = c->trackAllocations();
+      if (m_solving[i])
+      {
+        c->computeJointMotion(m_time);
+      }
+    });
+  }
+  std::vector<int> cpus;
+  int priority = 0;
+  nh.getParam("worker_cpus", cpus);
+  nh.getParam("worker_priority", priority);
+  if (!m_worker_pool.init(tasks, cpus, priority))
+  {
+    ROS_WARN("Continuing with default scheduling for the workers");
+  }
+
+  return true;
+}
+
+template <class HardwareInterface>
+void MultiChainMotionController<HardwareInterface>::
+starting(const ros::Time& time)
+{
+  for (auto& chain : m_chains)
+  {
+    chain->starting(time);
+  }
+}
+
+template <class HardwareInterface>
+void MultiChainMotionController<HardwareInterface>::
+stopping(const ros::Time& time)
+{
+  for (auto& chain : m_chains)
+  {
+    chain->stopping(time);
+  }
+}
+
+template <class HardwareInterface>
+void MultiChainMotionController<HardwareInterface>::
+update(const ros::Time& time, const ros::Duration& period)
+{
+  // Chains between their solver cycles only move on towards their last
+  // solution
+  for (size_t i = 0; i < m_chains.size(); ++i)
+  {
+    auto allocations = m_chains[i]->trackAllocations();
+    m_solving[i] = !m_chains[i]->interpolateJointControlCmds();
+  }
+
+  // Compute all chains in parallel and wait for them to finish
+  m_time = time;
+  m_worker_pool.run();
+
+  // Write final commands to the hardware interface
+  for (size_t i = 0; i < m_chains.size(); ++i)
+  {
+    if (m_solving[i])
+    {
+      auto allocations = m_chains[i]->trackAllocations();
+      m_chains[i]->writeJointControlCmds();
+    }
+  }
+}
+
+} // namespace
+
+#endif
@@ -42,6 +42,7 @@
 
 // Project
 #include <cartesian_motion_controller/cartesian_motion_controller.h>
+#include <cartesian_motion_controller/multi_chain_motion_controller.h>
 
 namespace position_controllers
 {
@@ -50,6 +51,12 @@ namespace position_controllers
    */
   typedef cartesian_motion_controller::CartesianMotionController<
     hardware_interface::PositionJointInterface> CartesianMotionController;
+
+  /**
+   * @brief Cartesian motion controller that drives several chains of position interfaces in parallel.
+   */
+  typedef cartesian_motion_controller::MultiChainMotionController<
+    hardware_interface::PositionJointInterface> MultiChainMotionController;
 }
 
 namespace velocity_controllers
@@ -59,7 +66,15 @@ namespace velocity_controllers
    */
   typedef cartesian_motion_controller::CartesianMotionController<
     hardware_interface::VelocityJointInterface> CartesianMotionController;
+
+  /**
+   * @brief Cartesian motion controller that drives several chains of velocity interfaces in parallel.
+   */
+  typedef cartesian_motion_controller::MultiChainMotionController<
+    hardware_interface::VelocityJointInterface> MultiChainMotionController;
 }
 
 PLUGINLIB_EXPORT_CLASS(position_controllers::CartesianMotionController, controller_interface::ControllerBase)
 PLUGINLIB_EXPORT_CLASS(velocity_controllers::CartesianMotionController, controller_interface::ControllerBase)
+PLUGINLIB_EXPORT_CLASS(position_controllers::MultiChainMotionController, controller_interface::ControllerBase)
+PLUGINLIB_EXPORT_CLASS(velocity_controllers::MultiChainMotionController, controller_interface::ControllerBase)
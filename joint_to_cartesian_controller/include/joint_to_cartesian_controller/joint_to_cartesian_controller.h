@@ -42,9 +42,12 @@
 
 // Project
 #include <joint_to_cartesian_controller/JointControllerAdapter.h>
+#include <cartesian_controller_base/TripleBuffer.h>
+#include <cartesian_controller_base/TargetRegistry.h>
 
 // ROS
 #include <geometry_msgs/PoseStamped.h>
+#include <realtime_tools/realtime_publisher.h>
 
 // ros_controls
 #include <controller_interface/controller.h>
@@ -75,6 +78,13 @@ namespace joint_to_cartesian_controller
  * provide an easy interface to the rqt_joint_trajectory_controller plugin and
  * MoveIt!.
  *
+ * By default, the internal controller manager runs in its own thread and the
+ * poses are published on a topic.  In synchronous mode, the internal
+ * controllers are updated within this controller's update() instead, and the
+ * poses go straight to a Cartesian controller in the same process that
+ * listens on the same target topic.  This saves the topic hop and the phase
+ * shift between both control loops.
+ *
  * Note, however, that transforming joint motion into Cartesian motion for
  * target following loses explicit control over the joints and collision checking.
  */
@@ -96,14 +106,24 @@ class JointToCartesianController
     std::string                m_end_effector_link;
     std::string                m_robot_base_link;
     std::string                m_target_frame_topic;
-    KDL::JntArray              m_positions;
     KDL::JntArray              m_velocities;
     std::vector<std::string>   m_joint_names;
-    ros::Publisher             m_pose_publisher;
+    realtime_tools::RealtimePublisherSharedPtr<geometry_msgs::PoseStamped> m_pose_publisher;
+
+    /**
+     * Joint commands of the internal controllers, handed over from the
+     * adapter thread to update() without locking.
+     */
+    std::unique_ptr<cartesian_controller_base::TripleBuffer<KDL::JntArray> > m_positions;
 
     std::unique_ptr<JointControllerAdapter> m_controller_adapter;
     std::thread m_adapter_thread;
-    std::mutex m_mutex;
+
+    // Synchronous mode
+    bool                                                       m_synchronous;
+    KDL::JntArray                                              m_synchronous_positions;
+    std::shared_ptr<cartesian_controller_base::TargetChannel>  m_target_channel;
+    std::unique_ptr<ros::AsyncSpinner>                         m_spinner;
 
 
     KDL::Chain m_robot_chain;
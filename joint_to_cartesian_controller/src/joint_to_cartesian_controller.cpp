@@ -39,13 +39,11 @@
 
 #include "ros/duration.h"
 #include "ros/rate.h"
+#include <cartesian_controller_base/RobotModelRegistry.h>
 #include <cartesian_controller_base/Utility.h>
 #include <joint_to_cartesian_controller/joint_to_cartesian_controller.h>
-#include <kdl/tree.hpp>
-#include <kdl_parser/kdl_parser.hpp>
 #include <memory>
 #include <pluginlib/class_list_macros.h>
-#include <urdf/model.h>
 
 namespace cartesian_controllers
 {
@@ -73,14 +71,13 @@ namespace joint_to_cartesian_controller
 {
 
 JointToCartesianController::JointToCartesianController()
+  : m_synchronous(false)
 {
 }
 
 bool JointToCartesianController::init(hardware_interface::JointStateInterface* hw, ros::NodeHandle& nh)
 {
   std::string robot_description;
-  urdf::Model robot_model;
-  KDL::Tree   robot_tree;
 
   // Get controller specific configuration
   if (!nh.getParam("/robot_description",robot_description))
@@ -108,23 +105,23 @@ bool JointToCartesianController::init(hardware_interface::JointStateInterface* h
         << nh.getNamespace() + m_target_frame_topic);
   }
 
+  nh.getParam("synchronous",m_synchronous);
+
   // Publishers
-  m_pose_publisher = nh.advertise<geometry_msgs::PoseStamped>(m_target_frame_topic,10);
+  m_pose_publisher = std::make_shared<realtime_tools::RealtimePublisher<geometry_msgs::PoseStamped> >(
+      nh, m_target_frame_topic, 10);
+  m_pose_publisher->lock();
+  m_pose_publisher->msg_.header.frame_id = m_robot_base_link;
+  m_pose_publisher->unlock();
 
   // Build a kinematic chain of the robot
-  if (!robot_model.initString(robot_description))
+  std::shared_ptr<const cartesian_controller_base::RobotModel> robot_model =
+    cartesian_controller_base::RobotModelRegistry::get(robot_description);
+  if (!robot_model)
   {
-    ROS_ERROR("Failed to parse urdf model from 'robot_description'");
     return false;
   }
-  if (!kdl_parser::treeFromUrdfModel(robot_model,robot_tree))
-  {
-    const std::string error = ""
-      "Failed to parse KDL tree from urdf model";
-    ROS_ERROR_STREAM(error);
-    throw std::runtime_error(error);
-  }
-  if (!robot_tree.getChain(m_robot_base_link,m_end_effector_link, m_robot_chain))
+  if (!robot_model->getChain(m_robot_base_link,m_end_effector_link, m_robot_chain))
   {
     const std::string error = ""
       "Failed to parse robot chain from urdf model. "
@@ -149,19 +146,43 @@ bool JointToCartesianController::init(hardware_interface::JointStateInterface* h
   }
 
   // Adjust joint buffers
-  m_positions.data = ctrl::VectorND::Zero(m_joint_state_handles.size());
+  KDL::JntArray positions(m_joint_state_handles.size());
+  m_positions = std::make_unique<cartesian_controller_base::TripleBuffer<KDL::JntArray> >(positions);
   m_velocities.data = ctrl::VectorND::Zero(m_joint_state_handles.size());
 
   // Initialize controller adapter and according manager
   m_controller_adapter = std::make_unique<JointControllerAdapter>(m_joint_state_handles,nh);
   m_controller_manager.reset(new controller_manager::ControllerManager(m_controller_adapter.get(), nh));
 
+  // Initialize forward kinematics solver
+  m_fk_solver.reset(new KDL::ChainFkSolverPos_recursive(m_robot_chain));
+
+  if (m_synchronous)
+  {
+    // The Cartesian controller on the other end of the target topic reads
+    // our poses directly.
+    m_target_channel = cartesian_controller_base::TargetRegistry::getWriter(
+        nh.resolveName(m_target_frame_topic), m_robot_base_link);
+    if (!m_target_channel)
+    {
+      return false;
+    }
+    m_synchronous_positions = positions;
+
+    // Callbacks of the internal controller manager
+    m_spinner = std::make_unique<ros::AsyncSpinner>(2);
+    m_spinner->start();
+    return true;
+  }
+
   // Process adapter callbacks even when we are not running.
   // This allows to interact with the adapter's controller manager without
   // freezes.  We use an idealized update rate since we republish joint
   // commands as Cartesian targets. The cartesian_controllers will interpolate
   // these targets for the robot driver's real control rate.
-  m_adapter_thread = std::thread([this] {
+  // Each cycle's joint commands are handed over without waiting for the
+  // realtime thread, so that none of them get lost.
+  m_adapter_thread = std::thread([this, positions]() mutable {
     constexpr int frequency = 100;
     auto rate               = ros::Rate(frequency);
     ros::AsyncSpinner spinner(2);
@@ -170,20 +191,14 @@ bool JointToCartesianController::init(hardware_interface::JointStateInterface* h
     {
       m_controller_adapter->read();
       m_controller_manager->update(ros::Time::now(), rate.expectedCycleTime());
-      if (m_mutex.try_lock())
-      {
-        m_controller_adapter->write(m_positions);
-        m_mutex.unlock();
-      }
+      m_controller_adapter->write(positions);
+      m_positions->writeFromNonRT(positions);
       rate.sleep();
     }
     spinner.stop();
   });
   m_adapter_thread.detach();  // gracefully die when our node shuts down.
 
-  // Initialize forward kinematics solver
-  m_fk_solver.reset(new KDL::ChainFkSolverPos_recursive(m_robot_chain));
-
   return true;
 }
 
@@ -197,16 +212,28 @@ void JointToCartesianController::stopping(const ros::Time& time)
 
 void JointToCartesianController::update(const ros::Time& time, const ros::Duration& period)
 {
-  if (m_mutex.try_lock())
+  if (m_synchronous)
   {
-    // Solve forward kinematics
+    // Step the internal controllers and forward their result in this cycle
+    m_controller_adapter->read();
+    m_controller_manager->update(time, period);
+    m_controller_adapter->write(m_synchronous_positions);
+
     KDL::Frame frame;
-    m_fk_solver->JntToCart(m_positions,frame);
+    m_fk_solver->JntToCart(m_synchronous_positions,frame);
+    m_target_channel->writeFromNonRT(frame);
+    return;
+  }
 
-    // Publish end-effector pose
-    geometry_msgs::PoseStamped target_pose = geometry_msgs::PoseStamped();
+  // Solve forward kinematics with the latest joint commands
+  KDL::Frame frame;
+  m_fk_solver->JntToCart(*m_positions->readFromRT(),frame);
+
+  // Publish end-effector pose
+  if (m_pose_publisher->trylock())
+  {
+    geometry_msgs::PoseStamped& target_pose = m_pose_publisher->msg_;
     target_pose.header.stamp = ros::Time::now();
-    target_pose.header.frame_id = m_robot_base_link;
     target_pose.pose.position.x = frame.p.x();
     target_pose.pose.position.y = frame.p.y();
     target_pose.pose.position.z = frame.p.z();
@@ -215,8 +242,7 @@ void JointToCartesianController::update(const ros::Time& time, const ros::Durati
         target_pose.pose.orientation.y,
         target_pose.pose.orientation.z,
         target_pose.pose.orientation.w);
-    m_pose_publisher.publish(target_pose);
-    m_mutex.unlock();
+    m_pose_publisher->unlockAndPublish();
   }
 }
 